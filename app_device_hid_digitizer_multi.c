@@ -22,102 +22,35 @@
 
 
 /********************************************************************
-To use this demo, program a device with the firmware from this project.
-Then plug the device into a Windows 7 or Windows Vista SP1+ based PC.
-
-MSDN documentation for the "WM_GESTURE" messages indicate that they are
-currently only supported in Windows 7.  WM_GESTURE messages can be used
-by PC applications to receive information related to a user's input.  
-However, Windows Vista SP1 still has some digitizer input 
-capabilities, and can therefore still be used to experiment with this demo.
-The demo experience will be superior under Windows 7 however, as not
-all touch related capabilities and features are enabled in Windows Vista.
-
-The device should enumerate as a HID class multi-touch capable
-digitizer device.  Windows 7 and Windows Vista features associated 
-with "Windows Touch" should automatically become activated.  
-Under default versions of Windows XP, the device should still enumerate 
-as a HID class device, but no new digitizer input functionality will 
-be activated.
-
-Digitizer tablets send absolute contact position information
-to the host.  This is a bit different compared to conventional mouse
-devices, in that mice send relative X/Y direction movement information,
-instead of an absolute location.
-
-Since the demo boards that this firmware is intended to be run on
-do not include an actual multi-touch tablet area, the firmware simply
-emulates the tablet by sending the same data (and formatting) that a tablet
-would actually be used to produce.  The demo board pushbutton "sw3"
-(see definition in the HardwareProfile - (board name).h file)
-can be used to make the demo board send simulated gesture info to the host.
-
-To use this demo, open up an Internet Explorer window, and go to some website 
-(ex: www.microchip.com/usb).
-The web page opened should be large enough that both vertical and 
-horizontal scrollbars will become active when zoomed in. Click on some 
-link, and then click the back button.  The purpose of this is to enable both 
-the forward and back buttons in the web broswer.  
-This demo will send gesture information to the OS that can be interpreted as 
-forward and back "flick" gestures, which can be used to control the web browser.
-
-Now try pressing the pushbutton on the demo board repeatedly.  Each press
-of the pushbutton should send a bunch of IN packets to the host, which contain
-the information that would typically be generated by a human user interacting 
-with a multi-touch capable digitizer screen.
-
-The firmware will send traffic to emulate both single touch and multi-touch 
-(up to 2 simultaneous contacts) gestures, based on the number of times the
-pushbutton has been pressed.  Under Windows 7 (Vista will be somewhat different),
-the following gestures will be sent and should be recognized by Internet Explorer:
-
-1.  Emulate a single touch "back" gesture operation.  
-		This is done by pressing only one finger down, and by moving it right quickly (X plus)
-2.  Emulate a single touch "forward" gesture operation.  
-		This is done by pressing only one finger down, and by moving it left quickly (X minus)
-3.  Emulate a multi-touch zoom-in operation ("un-pinch" index and thumb fingers)
-4.  Emulate a multi-touch zoom-in operation ("un-pinch" index and thumb fingers)
-5.  Emulate a multi-touch zoom-in operation ("un-pinch" index and thumb fingers)
-6.  Emulate a multi-touch horizontal scroll right operation 
-      This is done by using two fingers simultaneously and moving them both to the left (X minus)
-7.  Emulate a multi-touch horizontal scroll left operation
-      This is done by using two fingers simultaneously and moving them both to the right (X plus)
-8.  Emulate a single touch scroll down operation.  
-      This is done by pressing only one finger down, and by moving it down (Y plus)
-9.  Emulate a single touch scroll up operation.  
-      This is done by pressing only one finger down, and by moving it up (Y minus)
-10. Emulate a multi-touch zoom-out operation (pinch two fingers together)
-
-11+. Upon pressing the button 11 times, the firmware will go back to state 1. Subsequent 
-       presses of the button will step through and repeat the above gestures 1-10.
-
-Note: The above demo zooms in three times in a row (presses 3-5).  The purpose of this
-is to zoom in sufficiently so that the horizontal and vertical scoll bars will become
-active.  The gestures associated with button presses 6-9 perform scroll operations,
-but only if the scroll bars are active.
-
-Note2: This demo was tested and developed primarily on 64-bit Windows 7 beta build 7000, 
-with some additional testing on Windows Vista SP1.  At the time of this development,
-Windows 7 is not yet a finalized and released product.  If you have trouble getting
-this demo to work correctly, check to see if there is a later version of this demo
-available from the Microchip USB design center: www.microchip.com/usb
-
-Additionally, try adjusting some of the user adjustable controls for 
-Pen and Touch Input Devices.  These adjustments can be found from the control panel 
-within Windows.
-
-
-This demo is configured by default to support up to two simultaneous contacts,
-by using "parallel reporting" (all data for each contact is contained in each
-HID report packet sent to the host).  The demo can be modified to support additional
-contacts if the report descriptor in usb_config.h is modified, and the appropriate
-contact data is sent to the host for each HID report.
+This firmware enumerates as a HID class multi-touch digitizer, which
+Windows 7 and later (and Linux) pick up as a touch screen without any
+drivers.  Up to five contacts from the panel are sent in each input report
+using "parallel reporting" (all data for each contact is contained in each
+HID report packet sent to the host).
+
+Besides the contact count and device mode reports used by the host's touch
+stack, a set of feature reports configures and inspects the board:
+
+ 4  Backlight brightness (Monitor page, VESA Brightness)
+ 5  Stored configuration, see settings.h
+ 6  Boot diagnostics, see boot.h
+ 7  Runtime counters, see stats.h
+ 8  Latency histograms, see latency.h
+ 9  Synthetic touch generator, see synth.h
+
+The synthetic touch generator takes the place of the pushbutton gesture
+emulation in Microchip's original demo.  Writing report 9 starts a scripted
+multi-contact trajectory that is sent at the full report rate through the
+same packing path as panel frames, so host input stacks can be stress
+tested and report throughput measured without anyone touching the panel.
+Panel frames are not sent while it runs.
 ********************************************************************/
 
 
 /** INCLUDES *******************************************************/
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include <system.h>
 
@@ -125,6 +58,16 @@ contact data is sent to the host for each HID report.
 #include <usb/usb_device_hid.h>
 
 #include "touchpanel.h"
+#include "backlight.h"
+#include "transform.h"
+#include "settings.h"
+#include "i2c.h"
+#include "boot.h"
+#include "event.h"
+#include "stats.h"
+#include "latency.h"
+#include "trace.h"
+#include "synth.h"
 
 /** VARIABLES ******************************************************/
 /* Some processors have a limited range of RAM addresses where the USB module
@@ -149,15 +92,44 @@ contact data is sent to the host for each HID report.
 #endif
 USB_HANDLE lastTransmission;
 
-static bool HIDApplicationModeChanging;
+//GET_REPORT replies are built here.  EP0 carries one control transfer at a
+//time, so every feature report can share the one buffer.
+static union
+{
+    uint8_t contacts[2];
+    uint8_t mode[3];
+    uint8_t brightness[2];
+    uint8_t config[1 + sizeof(cfg_settings)];
+    uint8_t boot[1 + sizeof(boot_diag)];
+    uint8_t stats[1 + sizeof(stats_counters)];
+    uint8_t latency[1 + LAT_STAGES * LAT_BUCKETS];
+    uint8_t synth[1 + sizeof(syn_control)];
+} FeatureReport;
+
+static volatile bool HIDApplicationModeChanging;
+static uint8_t DeviceMode;
 static uint8_t DeviceIdentifier;
 
+//Brightness received in a SET_REPORT, applied from the main loop since the
+//control transfer completes in the USB interrupt.
+static volatile bool BrightnessChanged;
+static uint8_t BrightnessRequest;
+static volatile bool ConfigChanged;
+//Copied out of hid_report_out when the data stage completes, since the next
+//SET_REPORT reuses that buffer
+static cfg_settings ConfigRequest;
+static volatile bool SynthChanged;
+static syn_control SynthRequest;
+
 /** DEFINITIONS ****************************************************/
-//DeviceMode variable values.  See also the usb_config.h "DEFAULT_DEVICE_MODE" definition.
-#define MULTI_TOUCH_DIGITIZER_MODE      0x02
+//Time taken to ramp to a brightness set by the host
+#define BRIGHTNESS_FADE_MS              250
 
 /** Private Prototypes *********************************************/
 static void USBHIDCBSetReportComplete(void);
+static void USBHIDCBSetBrightnessComplete(void);
+static void USBHIDCBSetConfigComplete(void);
+static void USBHIDCBSetSynthComplete(void);
 
 /*********************************************************************
 * Function: void APP_DeviceHIDDigitizerInitialize(void);
@@ -182,11 +154,49 @@ void APP_DeviceHIDDigitizerInitialize()
 
     HIDApplicationModeChanging = false;
 
-    //Initialize device mode and digitizer emulation variables.
-    //--------------------------------------------------------
+    //Every new configuration starts out in the default mode, the host sets
+    //the mode it wants after enumeration.
+    DeviceMode = DEFAULT_DEVICE_MODE;
     DeviceIdentifier = 0x01;
 }
 
+/*********************************************************************
+* Function: uint8_t APP_DeviceHIDDigitizerMode(void);
+*
+* Overview: Returns the report format selected by the host
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: MOUSE_MODE, SINGLE_TOUCH_DIGITIZER_MODE or
+*   MULTI_TOUCH_DIGITIZER_MODE (see usb_config.h)
+*
+********************************************************************/
+uint8_t APP_DeviceHIDDigitizerMode()
+{
+    return DeviceMode;
+}
+
+/*********************************************************************
+* Function: bool APP_DeviceHIDDigitizerCanSend(void);
+*
+* Overview: Returns whether input reports may be sent on EP1 IN.  They
+*   may not while the host is changing the device mode, from the mode
+*   SET_REPORT until its data stage completes.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: false while the device mode is changing
+*
+********************************************************************/
+bool APP_DeviceHIDDigitizerCanSend()
+{
+    return (HIDApplicationModeChanging == false);
+}
+
 /*********************************************************************
 * Function: void APP_DeviceHIDDigitizerInitialize(void);
 *
@@ -201,20 +211,22 @@ void APP_DeviceHIDDigitizerInitialize()
 ********************************************************************/
 void APP_DeviceHIDDigitizerSOFHandler()
 {
-    // No need to clear UIRbits.SOFIF to 0 here.
-    // Callback caller is already doing that.
-
-    //Using SOF packets (which arrive at 1ms intervals) for time
-    //keeping purposes in this demo.  This enables this demo to send constant
-    //velocity contact point X/Y coordinate movement.
-    //SOFCount++;
+    //Synthetic frames go out as soon as the previous report has been
+    //collected, which is as fast as the host polls EP1 IN.  SOF packets
+    //arrive every 1ms, faster than the endpoint interval.
+    if(syn_active() && (HIDApplicationModeChanging == false) &&
+        (USBIsDeviceSuspended() == false) && !USBHandleBusy(lastTransmission))
+    {
+        syn_service();
+    }
 }
 
 
 /*********************************************************************
 * Function: void APP_DeviceHIDDigitizerTasks(void);
 *
-* Overview: Keeps the Custom HID demo running.
+* Overview: Applies settings received from the host.  Run from the main
+*   loop for EVT_HOST.
 *
 * PreCondition: The demo should have been initialized and started via
 *   the APP_DeviceHIDDigitizerInitialize() and APP_DeviceHIDDigitizerStart() demos
@@ -237,15 +249,48 @@ void APP_DeviceHIDDigitizerTasks()
         return;
     }
 
-    //Don't want to send any report packets on EP1 IN to the host when
-    //the host is in the process of sending a control transfer (ex: SET_REPORT)
-    //and is changing the device mode.  Need to wait until the control transfer
-    //is complete and the new device mode setting has taken effect.
-    if(HIDApplicationModeChanging == true)
+    if(BrightnessChanged == true)
     {
-        return;
+        BrightnessChanged = false;
+        bl_fade_to(BrightnessRequest, BRIGHTNESS_FADE_MS);
+        bl_save(BrightnessRequest);
+        TRACE(TRACE_SET_REPORT, BRIGHTNESS_FEATURE_REPORT_ID);
     }
 
+    //New settings from the host.  Touch frames are processed from the main
+    //loop as well, so they can be swapped in directly, then stored.  Settings
+    //that fail cfg_check() are dropped; the host can read back what is in use.
+    if(ConfigChanged == true)
+    {
+        cfg_settings request;
+
+        USBMaskInterrupts();
+        ConfigChanged = false;
+        request = ConfigRequest;
+        USBUnmaskInterrupts();
+
+        if(cfg_check(&request))
+        {
+            cfg = request;
+            tf_init();
+            i2c_SetDivider(cfg.i2c_sspadd);
+            cfg_save();
+            TRACE(TRACE_SET_REPORT, CONFIG_FEATURE_REPORT_ID);
+        }
+    }
+
+    if(SynthChanged == true)
+    {
+        syn_control request;
+
+        USBMaskInterrupts();
+        SynthChanged = false;
+        request = SynthRequest;
+        USBUnmaskInterrupts();
+
+        syn_start(&request);
+        TRACE(TRACE_SET_REPORT, SYNTH_FEATURE_REPORT_ID);
+    }
 }
 
 
@@ -283,11 +328,9 @@ void UserGetReportHandler(void)
     //is used for reporting the maximum number of supported simultaneous contacts (in multi-touch mode).
     if(SetupPkt.wValue == (0x0300 + VALID_CONTACTS_FEATURE_REPORT_ID))
     {
-        static uint8_t FeatureReport[2];
-
         //Prepare a response packet for the host
-        FeatureReport[0] = VALID_CONTACTS_FEATURE_REPORT_ID;
-        FeatureReport[1] = MAX_VALID_CONTACT_POINTS;	//Three contacts valid for this multi-touch demo (can be increased by increasing this number and editing report descriptor and report data payload)
+        FeatureReport.contacts[0] = VALID_CONTACTS_FEATURE_REPORT_ID;
+        FeatureReport.contacts[1] = MAX_VALID_CONTACT_POINTS;	//Three contacts valid for this multi-touch demo (can be increased by increasing this number and editing report descriptor and report data payload)
 
         //Determine number of bytes to send to the host
         if(SetupPkt.wLength < 2u)
@@ -302,7 +345,80 @@ void UserGetReportHandler(void)
         }
 
         //Now send the reponse packet data to the host, via the control transfer on EP0
-        USBEP0SendRAMPtr((uint8_t*)&FeatureReport, bytesToSend, USB_EP0_RAM);
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.contacts, bytesToSend, USB_EP0_RAM);
+    }
+    //Device mode feature report: byte 0 is the Report ID, byte 1 the Device
+    //Mode and byte 2 the Device Identifier.
+    else if(SetupPkt.wValue == (0x0300 + DEVICE_MODE_FEATURE_REPORT_ID))
+    {
+        FeatureReport.mode[0] = DEVICE_MODE_FEATURE_REPORT_ID;
+        FeatureReport.mode[1] = DeviceMode;
+        FeatureReport.mode[2] = DeviceIdentifier;
+
+        bytesToSend = (SetupPkt.wLength < 3u) ? SetupPkt.wLength : 3;
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.mode, bytesToSend, USB_EP0_RAM);
+    }
+    //Brightness feature report: byte 0 is the Report ID, byte 1 the current
+    //backlight level (VESA Brightness, 0-255).
+    else if(SetupPkt.wValue == (0x0300 + BRIGHTNESS_FEATURE_REPORT_ID))
+    {
+        FeatureReport.brightness[0] = BRIGHTNESS_FEATURE_REPORT_ID;
+        FeatureReport.brightness[1] = bl_get_level();
+
+        bytesToSend = (SetupPkt.wLength < 2u) ? SetupPkt.wLength : 2;
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.brightness, bytesToSend, USB_EP0_RAM);
+    }
+    //Configuration feature report: byte 0 is the Report ID, followed by the
+    //cfg_settings structure (see settings.h).
+    else if(SetupPkt.wValue == (0x0300 + CONFIG_FEATURE_REPORT_ID))
+    {
+        FeatureReport.config[0] = CONFIG_FEATURE_REPORT_ID;
+        memcpy(&FeatureReport.config[1], &cfg, sizeof(cfg_settings));
+
+        bytesToSend = (SetupPkt.wLength < sizeof(FeatureReport.config)) ? SetupPkt.wLength : sizeof(FeatureReport.config);
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.config, bytesToSend, USB_EP0_RAM);
+    }
+    //Boot diagnostics feature report: byte 0 is the Report ID, followed by
+    //the boot_diag structure (see boot.h).
+    else if(SetupPkt.wValue == (0x0300 + BOOT_FEATURE_REPORT_ID))
+    {
+        FeatureReport.boot[0] = BOOT_FEATURE_REPORT_ID;
+        boot_get_diag((boot_diag*)&FeatureReport.boot[1]);
+
+        bytesToSend = (SetupPkt.wLength < sizeof(FeatureReport.boot)) ? SetupPkt.wLength : sizeof(FeatureReport.boot);
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.boot, bytesToSend, USB_EP0_RAM);
+    }
+    //Counters feature report: byte 0 is the Report ID, followed by the
+    //stats_counters structure (see stats.h).  This runs in the USB interrupt,
+    //so the snapshot is only torn if a main loop increment was interrupted.
+    else if(SetupPkt.wValue == (0x0300 + STATS_FEATURE_REPORT_ID))
+    {
+        FeatureReport.stats[0] = STATS_FEATURE_REPORT_ID;
+        memcpy(&FeatureReport.stats[1], &stats, sizeof(stats_counters));
+
+        bytesToSend = (SetupPkt.wLength < sizeof(FeatureReport.stats)) ? SetupPkt.wLength : sizeof(FeatureReport.stats);
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.stats, bytesToSend, USB_EP0_RAM);
+    }
+    //Latency feature report: byte 0 is the Report ID, followed by one
+    //histogram of LAT_BUCKETS counts per stage (see latency.h).  Reading it
+    //starts the histograms over.
+    else if(SetupPkt.wValue == (0x0300 + LATENCY_FEATURE_REPORT_ID))
+    {
+        FeatureReport.latency[0] = LATENCY_FEATURE_REPORT_ID;
+        lat_dump(&FeatureReport.latency[1]);
+
+        bytesToSend = (SetupPkt.wLength < sizeof(FeatureReport.latency)) ? SetupPkt.wLength : sizeof(FeatureReport.latency);
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.latency, bytesToSend, USB_EP0_RAM);
+    }
+    //Synthetic touch feature report: byte 0 is the Report ID, followed by
+    //the syn_control structure (see synth.h) for the running script.
+    else if(SetupPkt.wValue == (0x0300 + SYNTH_FEATURE_REPORT_ID))
+    {
+        FeatureReport.synth[0] = SYNTH_FEATURE_REPORT_ID;
+        syn_get((syn_control*)&FeatureReport.synth[1]);
+
+        bytesToSend = (SetupPkt.wLength < sizeof(FeatureReport.synth)) ? SetupPkt.wLength : sizeof(FeatureReport.synth);
+        USBEP0SendRAMPtr((uint8_t*)&FeatureReport.synth, bytesToSend, USB_EP0_RAM);
     }
 }
 
@@ -333,8 +449,22 @@ void UserGetReportHandler(void)
  *******************************************************************/
 void UserSetReportHandler(void)
 {
+    //hid_report_out only holds HID_INT_OUT_EP_SIZE bytes, longer reports are
+    //left unanswered and stalled by the stack
+    if(SetupPkt.wLength > sizeof(hid_report_out))
+    {
+        return;
+    }
+
     if(SetupPkt.wValue == (0x0300 + DEVICE_MODE_FEATURE_REPORT_ID))	//Host is setting the device mode (ex: mouse, single-touch digitizer, multi-touch digitizer)
     {
+        //Report ID, mode and identifier, anything else is left unanswered
+        //and stalled by the stack
+        if(SetupPkt.wLength != 3u)
+        {
+            return;
+        }
+
         //Temporarily stop sending HID report data packets on EP1 IN until
         //the new mode has been fully set/takes effect.
         HIDApplicationModeChanging = true;
@@ -358,7 +488,32 @@ void UserSetReportHandler(void)
         }
 
         //Prepare EP0 to receive the control transfer data (the device mode to set)
-        USBEP0Receive((uint8_t*)&hid_report_out, SetupPkt.wLength, USBHIDCBSetReportComplete);	//Host will send two bytes.  After the two bytes are successfully received, call the USBHIDCBSetReportComplete() callback function.
+        USBEP0Receive((uint8_t*)&hid_report_out, SetupPkt.wLength, USBHIDCBSetReportComplete);	//Host will send three bytes.  After the three bytes are successfully received, call the USBHIDCBSetReportComplete() callback function.
+    }
+    else if(SetupPkt.wValue == (0x0300 + BRIGHTNESS_FEATURE_REPORT_ID))	//Host is setting the backlight brightness
+    {
+        //Report ID and level, anything else is left unanswered and stalled
+        //by the stack
+        if(SetupPkt.wLength == 2u)
+        {
+            USBEP0Receive((uint8_t*)&hid_report_out, SetupPkt.wLength, USBHIDCBSetBrightnessComplete);
+        }
+    }
+    else if(SetupPkt.wValue == (0x0300 + CONFIG_FEATURE_REPORT_ID))	//Host is replacing the stored configuration
+    {
+        //Only whole reports are accepted, anything else is left unanswered
+        //and stalled by the stack
+        if(SetupPkt.wLength == 1 + sizeof(cfg_settings))
+        {
+            USBEP0Receive((uint8_t*)&hid_report_out, SetupPkt.wLength, USBHIDCBSetConfigComplete);
+        }
+    }
+    else if(SetupPkt.wValue == (0x0300 + SYNTH_FEATURE_REPORT_ID))	//Host is starting or stopping the synthetic touch generator
+    {
+        if(SetupPkt.wLength == 1 + sizeof(syn_control))
+        {
+            USBEP0Receive((uint8_t*)&hid_report_out, SetupPkt.wLength, USBHIDCBSetSynthComplete);
+        }
     }
 }
 
@@ -371,8 +526,40 @@ static void USBHIDCBSetReportComplete(void)
     //The hid_report_out[1] byte contains the Device Mode
     //The hid_report_out[2] byte contains the DeviceIdentifier
 
+    //Unknown modes are ignored, the host can read back the mode in use
+    if(hid_report_out[1] <= MULTI_TOUCH_DIGITIZER_MODE)
+    {
+        DeviceMode = hid_report_out[1];
+        DeviceIdentifier = hid_report_out[2];
+    }
+
     //The new device mode setting has been set.  Okay to start sending HID report
     //packets again on EP1 IN now.
     HIDApplicationModeChanging = false;
 }
 
+//Called when the brightness SET_REPORT data stage completes.  The level is
+//handed to the main loop, which starts the fade.
+static void USBHIDCBSetBrightnessComplete(void)
+{
+    //hid_report_out[0] is the Report ID, hid_report_out[1] the brightness
+    BrightnessRequest = hid_report_out[1];
+    BrightnessChanged = true;
+    evt_post(EVT_HOST);
+}
+
+//Called when the configuration SET_REPORT data stage completes
+static void USBHIDCBSetConfigComplete(void)
+{
+    memcpy(&ConfigRequest, &hid_report_out[1], sizeof(cfg_settings));
+    ConfigChanged = true;
+    evt_post(EVT_HOST);
+}
+
+//Called when the synthetic touch SET_REPORT data stage completes
+static void USBHIDCBSetSynthComplete(void)
+{
+    memcpy(&SynthRequest, &hid_report_out[1], sizeof(syn_control));
+    SynthChanged = true;
+    evt_post(EVT_HOST);
+}
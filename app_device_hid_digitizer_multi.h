@@ -81,3 +81,33 @@ void APP_DeviceHIDDigitizerTasks();
 *
 ********************************************************************/
 void APP_DeviceHIDDigitizerSOFHandler();
+
+/*********************************************************************
+* Function: uint8_t APP_DeviceHIDDigitizerMode(void);
+*
+* Overview: Returns the report format selected by the host
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: MOUSE_MODE, SINGLE_TOUCH_DIGITIZER_MODE or
+*   MULTI_TOUCH_DIGITIZER_MODE (see usb_config.h)
+*
+********************************************************************/
+uint8_t APP_DeviceHIDDigitizerMode();
+
+/*********************************************************************
+* Function: bool APP_DeviceHIDDigitizerCanSend(void);
+*
+* Overview: Returns whether input reports may be sent on EP1 IN.  They
+*   may not while the host is changing the device mode.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: false while the device mode is changing
+*
+********************************************************************/
+bool APP_DeviceHIDDigitizerCanSend();
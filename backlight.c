@@ -1,34 +1,386 @@
 #include <xc.h>
+#include <stdint.h>
 #include "backlight.h"
+#include "tick.h"
+#include "settings.h"
 
 static unsigned char backlight_level = 0xFF;
 
+// Fade state. Positions are perceptual levels in 8.8 fixed point.
+static bool bl_fading;
+static unsigned int bl_fade_pos;
+static unsigned int bl_fade_end;
+static int bl_fade_step;
+
+// 10-bit PWM duty for every fourth perceptual level, gamma 2.2. Levels in
+// between are interpolated.
+static const unsigned int bl_gamma[65] = {
+       0,    0,    0,    1,    2,    4,    6,    8,
+      11,   14,   17,   21,   26,   31,   36,   42,
+      48,   55,   63,   71,   79,   88,   98,  108,
+     118,  129,  141,  153,  166,  179,  193,  208,
+     223,  238,  254,  271,  288,  306,  325,  344,
+     364,  384,  405,  426,  449,  471,  495,  519,
+     543,  568,  594,  621,  648,  676,  704,  733,
+     763,  793,  824,  855,  888,  920,  954,  988,
+    1023
+};
+
+static unsigned int bl_duty(unsigned int pos) {
+    const unsigned int *g = &bl_gamma[pos >> 10];
+    unsigned int duty;
+
+    duty = g[0] + (((g[1] - g[0]) * ((pos >> 2) & 0xFF)) >> 8);
+    // Keep the lowest levels distinguishable from off
+    if (pos >= 0x100 && !duty) duty = 1;
+    return duty;
+}
+
+#if BL_DIMMING == BL_DIMMING_EASYSCALE
+
+// EasyScale timing in Timer1 counts. The TPS61165 wants at least a 2:1 ratio
+// between the phases of a bit and accepts 2us to 360us per phase. Every
+// phase overshoots by the bl_es_delay() loop, a tick_fast() call or so, so
+// the short phase sits near the minimum and the long one at 5 times it,
+// which keeps the ratio above 2:1 whatever the overshoot. Low priority
+// interrupts stay masked for the whole command, so only the USB interrupt
+// can stretch the long phase, and it returns well within 360us.
+#define BL_ES_ADDRESS   0x72
+#define BL_ES_RFA       0x80
+#define BL_ES_SHORT     (4 * TICK_FAST_PER_US)
+#define BL_ES_LONG      (20 * TICK_FAST_PER_US)
+#define BL_ES_EDGE      (4 * TICK_FAST_PER_US) // Start and end of stream
+#define BL_ES_SHUTDOWN  (3000 * TICK_FAST_PER_US) // > 2.5ms resets the mode
+#define BL_ES_DELAY     (120 * TICK_FAST_PER_US) // t_es_delay > 100us
+#define BL_ES_DETECT    (300 * TICK_FAST_PER_US) // t_es_det > 260us
+#define BL_ES_WINDOW    (1000 * TICK_FAST_PER_US) // t_es_win
+#define BL_ES_ACK_WAIT  (600 * TICK_FAST_PER_US) // t_ACKN is 512us
+
+// Feedback voltage in mV for each EasyScale step, from the TPS61165
+// datasheet. Full scale matches 100% PWM duty.
+static const unsigned char bl_es_fb[32] = {
+      0,   5,   8,  11,  14,  17,  20,  23,
+     26,  29,  32,  35,  38,  44,  50,  56,
+     62,  68,  74,  80,  86,  92,  98, 104,
+    116, 128, 140, 152, 164, 176, 188, 200
+};
+
+// Step waiting to be sent from bl_tasks()
+static unsigned char bl_es_step;
+static bool bl_es_dirty;
+static bool bl_es_on;
+
+static void bl_es_delay(unsigned int counts) {
+    unsigned int start = tick_fast();
+
+    while ((unsigned int) (tick_fast() - start) < counts);
+}
+
+/**
+ * Nearest EasyScale step to a 10-bit PWM duty
+ *
+ * Both drive the same feedback voltage, so the gamma table is shared
+ * between the two dimming methods.
+ * @param duty
+ * @return
+ */
+static unsigned char bl_es_quantize(unsigned int duty) {
+    unsigned char mv = (unsigned char) (((uint32_t) duty * 200 + 511) / 1023);
+    unsigned char i = 1;
+
+    if (!duty) return 0;
+    while (i < 31 && bl_es_fb[i + 1] <= mv) i++;
+    if (i < 31 && mv - bl_es_fb[i] > bl_es_fb[i + 1] - mv) i++;
+    return i;
+}
+
+/**
+ * Send one EasyScale bit, starting from CTRL high
+ *
+ * Only the short phase of each bit is timed with interrupts masked. A
+ * logic 0 ends on its short high phase, so it returns with interrupts
+ * still masked and the falling edge of the next bit or end of stream
+ * closes the window.
+ * @param one
+ */
+static void bl_es_bit(bool one) {
+    INTCONbits.GIEH = 0;
+    LATCbits.LATC5 = 0;
+    if (one) {
+        bl_es_delay(BL_ES_SHORT);
+        LATCbits.LATC5 = 1;
+        INTCONbits.GIEH = 1;
+        bl_es_delay(BL_ES_LONG);
+    } else {
+        INTCONbits.GIEH = 1;
+        bl_es_delay(BL_ES_LONG);
+        INTCONbits.GIEH = 0;
+        LATCbits.LATC5 = 1;
+        bl_es_delay(BL_ES_SHORT);
+    }
+}
+
+static void bl_es_byte(unsigned char b) {
+    unsigned char i;
+
+    for (i = 0; i < 8; i++) {
+        bl_es_bit(b & 0x80);
+        b <<= 1;
+    }
+}
+
+/**
+ * Send a brightness step over EasyScale
+ * @param step 0 to 31
+ * @return false if an acknowledge was requested and not seen
+ */
+static bool bl_es_write(unsigned char step) {
+    bool ack = true;
+    unsigned char giel = INTCONbits.GIEL;
+
+    INTCONbits.GIEL = 0;
+    // Start condition, CTRL is already high
+    bl_es_delay(BL_ES_EDGE);
+    bl_es_byte(BL_ES_ADDRESS);
+#ifdef BL_ES_ACK
+    bl_es_byte(BL_ES_RFA | step);
+#else
+    bl_es_byte(step);
+#endif
+
+    // End of stream
+    INTCONbits.GIEH = 0;
+    LATCbits.LATC5 = 0;
+    INTCONbits.GIEH = 1;
+    bl_es_delay(BL_ES_EDGE);
+    LATCbits.LATC5 = 1;
+
+#ifdef BL_ES_ACK
+    {
+        unsigned int start;
+
+        // Release CTRL; the TPS61165 pulls it low for t_ACKN once the
+        // pull-up has had time to bring it high
+        TRISCbits.TRISC5 = 1;
+        bl_es_delay(BL_ES_EDGE);
+        ack = !PORTCbits.RC5;
+        start = tick_fast();
+        while (!PORTCbits.RC5
+                && (unsigned int) (tick_fast() - start) < BL_ES_ACK_WAIT);
+        TRISCbits.TRISC5 = 0;
+    }
+#endif
+    INTCONbits.GIEL = giel;
+    return ack;
+}
+
+/**
+ * Put the TPS61165 into EasyScale mode
+ *
+ * CTRL must go low for t_es_det within t_es_window of rising. The delays
+ * run with interrupts enabled, so the window is checked afterwards and the
+ * sequence repeated if an interrupt pushed it out.
+ * @return false if every try missed the window
+ */
+static bool bl_es_detect(void) {
+    unsigned char tries;
+    unsigned int start;
+
+    for (tries = 0; tries < 3; tries++) {
+        LATCbits.LATC5 = 0;
+        bl_es_delay(BL_ES_SHUTDOWN);
+
+        LATCbits.LATC5 = 1;
+        start = tick_fast();
+        bl_es_delay(BL_ES_DELAY);
+        LATCbits.LATC5 = 0;
+        bl_es_delay(BL_ES_DETECT);
+        LATCbits.LATC5 = 1;
+        if ((unsigned int) (tick_fast() - start) < BL_ES_WINDOW) return true;
+    }
+    return false;
+}
+
+static void bl_write_duty(unsigned int duty) {
+    bl_es_step = bl_es_quantize(duty);
+    bl_es_dirty = true;
+}
+
+#else
+
+static void bl_write_duty(unsigned int duty) {
+    CCPR1L = duty >> 2;
+    CCP1CONbits.DC1B = duty & 3;
+}
+
+#endif
+
 void bl_init(void) {
+#ifdef BL_PERSIST
+    backlight_level = cfg.bl_level;
+#endif
+
     TRISCbits.TRISC5 = 0;
     ANSELbits.ANS7 = 0;
-    CCP1CON |= 0x0C;
+    LATCbits.LATC5 = 0;
+
+#if BL_DIMMING == BL_DIMMING_EASYSCALE
+    // CTRL stays a plain output with P1A steering off
     PSTRCONbits.STRA = 0;
+#else
+    // PWM period = 4 * (PR2 + 1) / FOSC = 46.9kHz with full 10-bit duty
+    // resolution. The TPS61165 accepts 5kHz to 100kHz on CTRL.
+    PR2 = BL_PWM_PR2;
+    T2CON = 0b00000100; // Timer2 on, 1:1 prescale and postscale
+    CCP1CON = 0b00001100; // Single output PWM, P1A active high
+    PSTRCONbits.STRSYNC = 1; // Steering changes take effect on a period
+#endif
+    bl_write_duty(bl_duty(backlight_level << 8));
     bl_disable();
 }
 
-void bl_enable(void) {
-    LATCbits.LATC5 = 1;
+/**
+ * Turn the backlight on at the current level
+ *
+ * If the TPS61165 could not be put into EasyScale mode, CTRL is left high
+ * so the panel stays lit at full brightness, and the next call tries again.
+ * @return false if EasyScale detection failed
+ */
+bool bl_enable(void) {
+#if BL_DIMMING == BL_DIMMING_EASYSCALE
+    if (bl_es_on) return true;
+    if (!bl_es_detect()) return false;
+    bl_es_on = true;
+    bl_es_dirty = true;
+#else
+    PSTRCONbits.STRA = 1;
+#endif
+    return true;
 }
 
 void bl_disable(void) {
+#if BL_DIMMING == BL_DIMMING_EASYSCALE
+    bl_es_on = false;
+#else
+    // With steering off P1A follows LATC5, holding CTRL low shuts the
+    // TPS61165 down
+    PSTRCONbits.STRA = 0;
+#endif
     LATCbits.LATC5 = 0;
 }
 
+/**
+ * Set the perceptual brightness level immediately, cancelling any fade
+ * @param level 0 (off) to 255 (full)
+ */
 void bl_level(unsigned char level) {
+    bl_fade_cancel();
     backlight_level = level;
+    bl_write_duty(bl_duty(level << 8));
+}
+
+unsigned char bl_get_level(void) {
+    return backlight_level;
 }
 
 void bl_increase_level(void) {
-    backlight_level++;
-    CCPR1L = backlight_level;
+    if (backlight_level < 0xFF) bl_level(backlight_level + 1);
 }
 
 void bl_decrease_level(void) {
-    backlight_level--;
-    CCPR1L = backlight_level;
+    if (backlight_level > 0) bl_level(backlight_level - 1);
+}
+
+/**
+ * Ramp to a brightness level over a period of time
+ *
+ * The ramp is linear in perceptual level and advanced on each tick from
+ * the main loop, so this returns immediately. Calling it again during a fade
+ * retargets from the current position.
+ * @param level Target level
+ * @param ms Duration in milliseconds, 0 to jump straight there
+ */
+void bl_fade_to(unsigned char level, unsigned int ms) {
+    int32_t step;
+
+    if (ms == 0) {
+        bl_level(level);
+        return;
+    }
+
+    if (!bl_fading) bl_fade_pos = (unsigned int) backlight_level << 8;
+    bl_fade_end = (unsigned int) level << 8;
+
+    step = ((int32_t) bl_fade_end - (int32_t) bl_fade_pos) / (int32_t) ms;
+    if (step == 0) step = (bl_fade_end > bl_fade_pos) ? 1 : -1;
+    bl_fade_step = (int) step;
+    bl_fading = (bl_fade_end != bl_fade_pos);
+}
+
+/**
+ * Stop a fade at its current level
+ */
+void bl_fade_cancel(void) {
+    bl_fading = false;
+}
+
+bool bl_fade_busy(void) {
+    return bl_fading;
+}
+
+/**
+ * Advance the fade by one tick
+ *
+ * Called from the main loop once for every tick that has elapsed.
+ */
+void bl_fade_service(void) {
+    unsigned int pos;
+
+    if (!bl_fading) return;
+
+    pos = bl_fade_pos + bl_fade_step;
+    // Stop at the target, including when the step carried past it or
+    // wrapped around
+    if ((bl_fade_step > 0 && (pos >= bl_fade_end || pos < bl_fade_pos))
+            || (bl_fade_step < 0 && (pos <= bl_fade_end || pos > bl_fade_pos))) {
+        pos = bl_fade_end;
+        bl_fading = false;
+    }
+    bl_fade_pos = pos;
+
+    backlight_level = pos >> 8;
+    bl_write_duty(bl_duty(pos));
+}
+
+/**
+ * Remember a level as the power-on brightness
+ * @param level
+ */
+void bl_save(unsigned char level) {
+#ifdef BL_PERSIST
+    if (cfg.bl_level == level) return;
+    cfg.bl_level = level;
+    cfg_save();
+#endif
+}
+
+/**
+ * Send pending brightness changes
+ *
+ * Called from the main loop. EasyScale commands take a few hundred
+ * microseconds, so level changes and fade steps only record the latest
+ * step and it is sent from here once per pass. Nothing to do for PWM.
+ */
+void bl_tasks(void) {
+#if BL_DIMMING == BL_DIMMING_EASYSCALE
+    unsigned char step;
+
+    if (!bl_es_on || !bl_es_dirty) return;
+
+    step = bl_es_step;
+    bl_es_dirty = false;
+
+    // Retried on the next pass if the acknowledge was missed
+    if (!bl_es_write(step)) bl_es_dirty = true;
+#endif
 }
@@ -8,16 +8,46 @@
 #ifndef BACKLIGHT_H
 #define	BACKLIGHT_H
 
+#include <stdbool.h>
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
+// Dimming method on CTRL (RC5). PWM uses CCP1; EasyScale sends the
+// brightness as a digital command and keeps CTRL high, so the LED current
+// is never chopped.
+#define BL_DIMMING_PWM          0
+#define BL_DIMMING_EASYSCALE    1
+
+#ifndef BL_DIMMING
+#define BL_DIMMING  BL_DIMMING_PWM
+#endif
+
+// Timer2 period register for the CCP1 PWM
+#define BL_PWM_PR2  0xFF
+
+// Define to keep the level set with bl_save() across power cycles, in the
+// configuration store
+#define BL_PERSIST
+
+// Define to request and check the EasyScale acknowledge. The TPS61165 can
+// only pull CTRL low against a pull-up, so this needs one fitted on RC5.
+//#define BL_ES_ACK
+
 void bl_init(void);
-void bl_enable(void);
+bool bl_enable(void);
 void bl_disable(void);
 void bl_level(unsigned char level);
+unsigned char bl_get_level(void);
 void bl_increase_level(void);
 void bl_decrease_level(void);
+void bl_fade_to(unsigned char level, unsigned int ms);
+void bl_fade_cancel(void);
+bool bl_fade_busy(void);
+void bl_fade_service(void);
+void bl_save(unsigned char level);
+void bl_tasks(void);
 
 #ifdef	__cplusplus
 }
@@ -0,0 +1,118 @@
+#include <xc.h>
+#include <stdbool.h>
+#include "boot.h"
+#include "tick.h"
+#include "touchpanel.h"
+#include "backlight.h"
+#include "trace.h"
+
+#define BOOT_STEP_RESET 0
+#define BOOT_STEP_POLL  1
+#define BOOT_STEP_DONE  2
+
+static unsigned char boot_step;
+static unsigned int boot_wait; // Tick at which the current step runs
+static unsigned int boot_woken; // Tick reset was released
+static boot_diag boot_data;
+
+/**
+ * Start the sequencer
+ *
+ * Called once the pins are set up by bl_init() and tp_init(), with the
+ * controller held in reset. The remaining steps run from boot_tasks()
+ * while the USB interrupt handles enumeration.
+ */
+void boot_init(void) {
+    boot_step = BOOT_STEP_RESET;
+    boot_wait = tick_get() + BOOT_RESET_MS;
+}
+
+/**
+ * Record the time a stage was first reached
+ *
+ * Called from the main loop; the USB interrupt posts EVT_CONFIGURED rather
+ * than marking that stage itself. Later calls for a stage are ignored.
+ * @param stage
+ */
+void boot_mark(unsigned char stage) {
+    unsigned int now;
+
+    if (boot_data.stamp[stage]) return;
+    now = tick_get();
+    boot_data.stamp[stage] = now ? now : 1;
+    TRACE(TRACE_BOOT_STAGE, stage);
+}
+
+/**
+ * Wait for the controller again after it has been held in reset
+ *
+ * Called once reset is released. boot_tasks() polls it as at power up and
+ * enables its interrupt once it answers.
+ */
+void boot_restart(void) {
+    boot_woken = tick_get();
+    boot_wait = boot_woken + BOOT_POLL_START_MS;
+    boot_step = BOOT_STEP_POLL;
+}
+
+bool boot_done(void) {
+    return boot_step == BOOT_STEP_DONE;
+}
+
+/**
+ * Run the next bring-up step once it is due
+ *
+ * Called from the main loop. Nothing here blocks, apart from the I2C
+ * readiness read.
+ */
+void boot_tasks(void) {
+    unsigned int now;
+    unsigned char vendor;
+
+    if (boot_step == BOOT_STEP_DONE) return;
+    now = tick_get();
+    if ((int) (now - boot_wait) < 0) return;
+
+    switch (boot_step) {
+        case BOOT_STEP_RESET:
+            tp_wake();
+            boot_woken = now;
+            boot_mark(BOOT_STAGE_TP_WAKE);
+
+            // The backlight needs nothing from the controller
+            if (!bl_enable()) boot_data.flags |= BOOT_FLAG_BL_DETECT;
+            boot_mark(BOOT_STAGE_BL_ON);
+
+            boot_wait = now + BOOT_POLL_START_MS;
+            boot_step = BOOT_STEP_POLL;
+            break;
+
+        case BOOT_STEP_POLL:
+            vendor = tp_read_reg(TP_REG_VENDOR);
+            if (vendor == 0xFF || vendor == 0x00) {
+                if (now - boot_woken < BOOT_READY_TIMEOUT_MS) {
+                    boot_wait = now + BOOT_POLL_MS;
+                    break;
+                }
+                boot_data.flags |= BOOT_FLAG_TP_TIMEOUT;
+            } else {
+                boot_data.tp_vendor = vendor;
+                boot_data.tp_firmware = tp_read_reg(TP_REG_FIRMWARE);
+            }
+
+            tp_enable();
+            boot_mark(BOOT_STAGE_TP_READY);
+            boot_step = BOOT_STEP_DONE;
+            break;
+    }
+}
+
+/**
+ * Copy the diagnostics for the feature report
+ *
+ * Called from the USB interrupt, so the copy is never interrupted.
+ * @param diag
+ */
+void boot_get_diag(boot_diag *diag) {
+    *diag = boot_data;
+}
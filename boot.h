@@ -0,0 +1,58 @@
+/*
+ * File:   boot.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef BOOT_H
+#define	BOOT_H
+
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Time the controller is held in reset after power-on
+#define BOOT_RESET_MS       5
+// Earliest readiness poll after reset is released, and the poll interval.
+// The FT5x06 typically answers about 200ms after reset.
+#define BOOT_POLL_START_MS  20
+#define BOOT_POLL_MS        10
+// Give up waiting and enable the controller anyway
+#define BOOT_READY_TIMEOUT_MS 500
+
+// Stages recorded in the diagnostics report
+#define BOOT_STAGE_TP_WAKE      0 // Controller reset released
+#define BOOT_STAGE_BL_ON        1 // Backlight enabled
+#define BOOT_STAGE_TP_READY     2 // Controller answered, interrupt enabled
+#define BOOT_STAGE_CONFIGURED   3 // Host configured the device
+#define BOOT_STAGE_FIRST_TOUCH  4 // First report sent to the host
+#define BOOT_STAGES             5
+
+// boot_diag.flags
+#define BOOT_FLAG_TP_TIMEOUT    0x01 // Controller never answered
+#define BOOT_FLAG_BL_DETECT     0x02 // EasyScale detection failed
+
+// Diagnostics feature report payload. Stamps are milliseconds since reset,
+// 0 for stages not reached yet.
+typedef struct {
+    unsigned int stamp[BOOT_STAGES];
+    unsigned char flags;
+    unsigned char tp_vendor;
+    unsigned char tp_firmware;
+} boot_diag;
+
+void boot_init(void);
+void boot_tasks(void);
+void boot_restart(void);
+bool boot_done(void);
+void boot_mark(unsigned char stage);
+void boot_get_diag(boot_diag *diag);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* BOOT_H */
+
@@ -0,0 +1,64 @@
+#include <xc.h>
+#include "contact_id.h"
+
+#define CID_CTRL_IDS    16 // TOUCHn_ID is 4 bits wide
+#define CID_NONE        0xFF
+
+// Host ID currently assigned to each controller ID
+static unsigned char cid_map[CID_CTRL_IDS];
+// Host IDs in use, one bit per ID
+static unsigned char cid_used;
+
+#if TP_MAX_POINTS != 5
+#error "cid_first_free is written out for 5 contacts"
+#endif
+
+// Lowest clear bit of a 5 bit mask, CID_NONE if all are set
+static const unsigned char cid_first_free[1 << TP_MAX_POINTS] = {
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, CID_NONE
+};
+
+void cid_reset(void) {
+    unsigned char i;
+
+    for (i = 0; i < CID_CTRL_IDS; i++) {
+        cid_map[i] = CID_NONE;
+    }
+    cid_used = 0;
+}
+
+/**
+ * Replace controller contact IDs with compact host IDs
+ *
+ * A host ID is held for the whole lifetime of a contact, from touch-down
+ * until the frame reporting its lift, so the host never sees a contact
+ * change identity mid-stroke.
+ * @param pts Filtered contacts
+ * @param count Number of contacts
+ */
+void cid_assign(touch_point *pts, unsigned char count) {
+    unsigned char i;
+    unsigned char ctrl;
+    unsigned char host;
+
+    for (i = 0; i < count; i++) {
+        ctrl = pts[i].id & (CID_CTRL_IDS - 1);
+        host = cid_map[ctrl];
+
+        if (host == CID_NONE) {
+            host = cid_first_free[cid_used];
+            // Can't happen with at most TP_MAX_POINTS contacts
+            if (host == CID_NONE) host = 0;
+            cid_used |= 1 << host;
+            cid_map[ctrl] = host;
+        }
+
+        if (pts[i].event == TP_EVENT_UP) {
+            cid_used &= ~(1 << host);
+            cid_map[ctrl] = CID_NONE;
+        }
+
+        pts[i].id = host;
+    }
+}
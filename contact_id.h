@@ -0,0 +1,24 @@
+/*
+ * File:   contact_id.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef CONTACT_ID_H
+#define	CONTACT_ID_H
+
+#include "touchpanel.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+void cid_reset(void);
+void cid_assign(touch_point *pts, unsigned char count);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* CONTACT_ID_H */
+
@@ -0,0 +1,77 @@
+#include <xc.h>
+#include "event.h"
+#include "usb/usb_struct_queue.h"
+
+typedef struct {
+    unsigned char head;
+    unsigned char tail;
+    unsigned char count;
+    unsigned char buffer[EVT_COUNT];
+} evt_queue;
+
+static evt_queue evt_q;
+static unsigned int evt_pending; // Bit n set while event n is queued
+
+void evt_init(void) {
+    StructQueueInit(&evt_q, EVT_COUNT);
+    evt_pending = 0;
+}
+
+/**
+ * Queue an event for the main loop
+ *
+ * Safe to call from either interrupt. Both priorities are masked while the
+ * queue is updated, and left as they were found, so a call from the
+ * high-priority interrupt does not re-enable it.
+ * @param evt
+ */
+void evt_post(unsigned char evt) {
+    unsigned char gieh = INTCONbits.GIEH;
+    unsigned int bit = 1u << evt;
+
+    INTCONbits.GIEH = 0;
+    if (!(evt_pending & bit)) {
+        evt_pending |= bit;
+        *StructQueueAdd(&evt_q, EVT_COUNT) = evt;
+    }
+    INTCONbits.GIEH = gieh;
+}
+
+/**
+ * Take the oldest event off the queue
+ *
+ * Called from the main loop.
+ * @return The event, or EVT_NONE if the queue is empty
+ */
+unsigned char evt_get(void) {
+    unsigned char evt = EVT_NONE;
+
+    INTCONbits.GIEH = 0;
+    if (StructQueueIsNotEmpty(&evt_q, EVT_COUNT)) {
+        evt = *StructQueueRemove(&evt_q, EVT_COUNT);
+        evt_pending &= ~(1u << evt);
+    }
+    INTCONbits.GIEH = 1;
+    return evt;
+}
+
+/**
+ * Idle the CPU until the next interrupt
+ *
+ * Interrupts are masked while the queue is checked so an event posted just
+ * before SLEEP cannot be missed: a pending interrupt still wakes the core,
+ * and it is serviced once they are unmasked. In IDLE mode the peripheral
+ * clock keeps running, so the USB module, timers and MSSP carry on. In
+ * SLEEP the oscillator stops, Timer0 and its tick with it, so only
+ * interrupts that need no clock, USB activity and the controller's INT1,
+ * wake the core.
+ * @param deep SLEEP rather than IDLE, while the bus is suspended
+ */
+void evt_idle(bool deep) {
+    INTCONbits.GIEH = 0;
+    if (StructQueueIsEmpty(&evt_q, EVT_COUNT)) {
+        OSCCONbits.IDLEN = !deep;
+        SLEEP();
+    }
+    INTCONbits.GIEH = 1;
+}
@@ -0,0 +1,40 @@
+/*
+ * File:   event.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef EVENT_H
+#define	EVENT_H
+
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Events posted by the interrupts and handled in the main loop. An event
+// that is already pending is not queued again, so the queue holds at most
+// one entry per type and can never overflow.
+#define EVT_NONE        0
+#define EVT_TOUCH       1 // Controller signalled a new frame
+#define EVT_TICK        2 // One or more system ticks elapsed
+#define EVT_SOF         3 // USB start of frame
+#define EVT_EEPROM      4 // EEPROM write finished or requested
+#define EVT_HOST        5 // SET_REPORT data from the host
+#define EVT_SUSPEND     6 // USB bus suspended
+#define EVT_RESUME      7 // USB bus resumed
+#define EVT_CONFIGURED  8 // Host configured the device
+#define EVT_COUNT       8
+
+void evt_init(void);
+void evt_post(unsigned char evt);
+unsigned char evt_get(void);
+void evt_idle(bool deep);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* EVENT_H */
+
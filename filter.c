@@ -0,0 +1,144 @@
+#include <xc.h>
+#include <stdbool.h>
+#include "filter.h"
+#include "settings.h"
+
+#define FLT_FREE 0xFF
+
+typedef struct {
+    unsigned char id; // Controller contact ID, FLT_FREE if unused
+    unsigned char frames; // Consecutive frames seen, saturates
+    unsigned char rejects; // Consecutive rejected jumps
+    bool reported; // Touch-down has been sent to the host
+    unsigned int hx[2]; // Previous two raw samples for the median
+    unsigned int hy[2];
+    unsigned int x; // Last accepted position
+    unsigned int y;
+    unsigned char area;
+} flt_slot;
+
+static flt_slot flt_slots[TP_MAX_POINTS];
+
+static unsigned int flt_median(unsigned int a, unsigned int b, unsigned int c) {
+    if (a > b) {
+        if (b > c) return b;
+        return (a > c) ? c : a;
+    }
+    if (a > c) return a;
+    return (b > c) ? c : b;
+}
+
+static unsigned int flt_distance(unsigned int a, unsigned int b) {
+    return (a > b) ? a - b : b - a;
+}
+
+void flt_reset(void) {
+    unsigned char i;
+
+    for (i = 0; i < TP_MAX_POINTS; i++) {
+        flt_slots[i].id = FLT_FREE;
+    }
+}
+
+static flt_slot *flt_find(unsigned char id) {
+    unsigned char i;
+    flt_slot *free = 0;
+
+    for (i = 0; i < TP_MAX_POINTS; i++) {
+        if (flt_slots[i].id == id) return &flt_slots[i];
+        if (!free && flt_slots[i].id == FLT_FREE) free = &flt_slots[i];
+    }
+    if (free) {
+        free->id = id;
+        free->frames = 0;
+        free->rejects = 0;
+        free->reported = false;
+    }
+    return free;
+}
+
+static void flt_track(flt_slot *s, const touch_point *pt) {
+    unsigned int x = pt->x;
+    unsigned int y = pt->y;
+
+    s->area = pt->area;
+    if (s->frames == 0) {
+        s->hx[0] = s->hx[1] = x;
+        s->hy[0] = s->hy[1] = y;
+        s->x = x;
+        s->y = y;
+        s->frames = 1;
+        return;
+    }
+
+    // Median of the last three samples removes single-frame spikes
+    x = flt_median(s->hx[0], s->hx[1], pt->x);
+    y = flt_median(s->hy[0], s->hy[1], pt->y);
+    s->hx[0] = s->hx[1];
+    s->hx[1] = pt->x;
+    s->hy[0] = s->hy[1];
+    s->hy[1] = pt->y;
+
+    if (s->frames < cfg.flt_down_frames) s->frames++;
+
+    // Hold the last position across physically impossible jumps, unless the
+    // contact stays at the new location
+    if (flt_distance(x, s->x) > cfg.flt_max_jump
+            || flt_distance(y, s->y) > cfg.flt_max_jump) {
+        if (++s->rejects < cfg.flt_jump_frames) return;
+    }
+    s->rejects = 0;
+    s->x = x;
+    s->y = y;
+}
+
+/**
+ * Filter one frame of contacts
+ *
+ * Contacts are only passed on once they have been seen for
+ * cfg.flt_down_frames frames. Contacts that were reported and have
+ * disappeared are emitted once more with TP_EVENT_UP so the host sees the
+ * lift.
+ * @param in Raw contacts from the controller
+ * @param count Number of raw contacts
+ * @param out Filtered contacts, room for TP_MAX_POINTS
+ * @return Number of filtered contacts
+ */
+unsigned char flt_apply(const touch_point *in, unsigned char count,
+        touch_point *out) {
+    unsigned char i;
+    unsigned char seen = 0;
+    unsigned char n = 0;
+    flt_slot *s;
+
+    for (i = 0; i < count; i++) {
+        // Lifted contacts are dropped here and re-emitted below
+        if (in[i].event == TP_EVENT_UP) continue;
+        s = flt_find(in[i].id);
+        if (!s) continue;
+        seen |= 1 << (s - flt_slots);
+        flt_track(s, &in[i]);
+    }
+
+    for (i = 0; i < TP_MAX_POINTS; i++) {
+        s = &flt_slots[i];
+        if (s->id == FLT_FREE) continue;
+
+        out[n].id = s->id;
+        if (seen & (1 << i)) {
+            if (s->frames < cfg.flt_down_frames) continue;
+            out[n].event = s->reported ? TP_EVENT_CONTACT : TP_EVENT_DOWN;
+            s->reported = true;
+        } else {
+            s->id = FLT_FREE;
+            if (!s->reported) continue;
+            out[n].event = TP_EVENT_UP;
+        }
+        out[n].x = s->x;
+        out[n].y = s->y;
+        out[n].area = s->area;
+        n++;
+    }
+
+    return n;
+}
@@ -0,0 +1,43 @@
+/*
+ * File:   filter.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef FILTER_H
+#define	FILTER_H
+
+#include "touchpanel.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Defaults for the configuration store, which holds the values in use
+
+// Consecutive frames a new contact must be seen before touch-down is
+// reported. 1 reports on the first frame.
+#ifndef FLT_DOWN_FRAMES
+#define FLT_DOWN_FRAMES 2
+#endif
+
+// Largest per-frame movement, in report units, accepted as a real finger
+#ifndef FLT_MAX_JUMP
+#define FLT_MAX_JUMP    200
+#endif
+
+// Consecutive rejected jumps after which the new position is accepted
+#ifndef FLT_JUMP_FRAMES
+#define FLT_JUMP_FRAMES 3
+#endif
+
+void flt_reset(void);
+unsigned char flt_apply(const touch_point *in, unsigned char count,
+        touch_point *out);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* FILTER_H */
+
@@ -23,10 +23,20 @@
 #ifndef FIXED_MEMORY_ADDRESS_H
 #define FIXED_MEMORY_ADDRESS_H
 
+#include "usb_config.h"
+
 #define FIXED_ADDRESS_MEMORY
 
+//USB RAM is 0x200-0x2FF.  The stack places the BDT at 0x200 (32 bytes with
+//full ping-pong on two endpoints), then the EP0 setup and data buffers, each
+//USB_EP0_BUFF_SIZE bytes.
+#if (USB_EP0_BUFF_SIZE == 64)
+#define DEVICE_HID_DIGITIZER_IN_BUFFER_ADDRESS      @0x2A0
+#define DEVICE_HID_DIGITIZER_OUT_BUFFER_ADDRESS     @0x2E0
+#else
 #define DEVICE_HID_DIGITIZER_IN_BUFFER_ADDRESS      @0x240
 #define DEVICE_HID_DIGITIZER_OUT_BUFFER_ADDRESS     @0x280
 #define CONTROL_BUFFER_ADDRESS_TAG                  @0x2C0
+#endif
 
 #endif //FIXED_MEMORY_ADDRESS
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * File:   hid_layout.h
+ *
+ * Created on October 19, 2026
+ */
+
+// Generated by tools/hid_layout.py together with the report descriptor in
+// usb_descriptors.c, edit the table there and run it again.
+
+#ifndef HID_LAYOUT_H
+#define	HID_LAYOUT_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#define HID_RPT01_SIZE          626u
+
+// Input report 1, offsets from the report ID byte
+#define TP_RPT_MULTI_LEN        37
+#define TP_RPT_MULTI_FINGER     1
+#define TP_RPT_MULTI_FINGER_STRIDE 7
+#define TP_RPT_MULTI_COUNT      36
+// Within each finger
+#define TP_RPT_FINGER_FLAGS     0
+#define TP_RPT_FINGER_TIP       0x01
+#define TP_RPT_FINGER_RANGE     0x02
+#define TP_RPT_FINGER_CONFIDENCE 0x04
+#define TP_RPT_FINGER_ID_SHIFT  3
+#define TP_RPT_FINGER_X         1
+#define TP_RPT_FINGER_Y         3
+#define TP_RPT_FINGER_WIDTH     5
+#define TP_RPT_FINGER_HEIGHT    6
+
+// Input report 10, offsets from the report ID byte
+#define TP_RPT_MOUSE_LEN        6
+#define TP_RPT_MOUSE_BUTTONS    1
+#define TP_RPT_MOUSE_LEFT       0x01
+#define TP_RPT_MOUSE_RIGHT      0x02
+#define TP_RPT_MOUSE_X          2
+#define TP_RPT_MOUSE_Y          4
+
+// Input report 11, offsets from the report ID byte
+#define TP_RPT_SINGLE_LEN       6
+#define TP_RPT_SINGLE_FLAGS     1
+#define TP_RPT_SINGLE_TIP       0x01
+#define TP_RPT_SINGLE_RANGE     0x02
+#define TP_RPT_SINGLE_X         2
+#define TP_RPT_SINGLE_Y         4
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* HID_LAYOUT_H */
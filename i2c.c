@@ -1,6 +1,8 @@
 #include <xc.h>
 #include "i2c.h"
 
+static unsigned char i2c_ErrorFlags;
+
 // Initialise MSSP port. (12F1822 - other devices may differ)
 void i2c_Init(void){
 
@@ -18,9 +20,38 @@ void i2c_Init(void){
 
 }
 
+// i2c_SetDivider - Set the clock, FOSC / (4 * (divider + 1))
+void i2c_SetDivider(unsigned char divider){
+    SSPADD = divider;
+}
+
 // i2c_Wait - wait for I2C transfer to finish
+// A transfer that never finishes resets the MSSP rather than hanging
 void i2c_Wait(void){
-    while ( ( SSPCON2 & 0x1F ) || ( SSPSTAT & 0x04 ) );
+    unsigned int timeout = I2C_TIMEOUT;
+
+    while ( ( SSPCON2 & 0x1F ) || ( SSPSTAT & 0x04 ) ) {
+        if (--timeout == 0) {
+            i2c_ErrorFlags |= I2C_ERR_TIMEOUT;
+            SSPCON1bits.SSPEN = 0;
+            SSPCON1bits.SSPEN = 1;
+            return;
+        }
+    }
+}
+
+// i2c_Errors - Return and clear the errors seen since the last call
+unsigned char i2c_Errors(void){
+    unsigned char errors = i2c_ErrorFlags;
+
+    i2c_ErrorFlags = 0;
+    return errors;
+}
+
+// i2c_CheckAck - wait for a sent byte and record a missing acknowledge
+static void i2c_CheckAck(void){
+    i2c_Wait();
+    if (SSPCON2bits.ACKSTAT) i2c_ErrorFlags |= I2C_ERR_NAK;
 }
 
 // i2c_Start - Start I2C communication
@@ -48,6 +79,7 @@ void i2c_Write(unsigned char data)
 {
  	i2c_Wait();
  	SSPBUF = data;
+ 	i2c_CheckAck();
 }
 
 // i2c_Address - Sends Slave Address and Read/Write mode
@@ -60,6 +92,7 @@ void i2c_Address(unsigned char address, unsigned char mode)
 	l_address+=mode;
  	i2c_Wait();
  	SSPBUF = l_address;
+ 	i2c_CheckAck();
 }
 
 // i2c_Read - Reads a byte from Slave device
@@ -11,6 +11,13 @@
 #define I2C_WRITE 0
 #define I2C_READ 1
 
+// Error flags returned by i2c_Errors()
+#define I2C_ERR_TIMEOUT 0x01
+#define I2C_ERR_NAK     0x02
+
+// i2c_Wait polls before giving up on a stuck bus, about 2ms at 12 MIPS
+#define I2C_TIMEOUT 2000
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
@@ -18,9 +25,15 @@ extern "C" {
 // Initialise MSSP port. (12F1822 - other devices may differ)
 void i2c_Init(void);
 
+// i2c_SetDivider - Set the clock, FOSC / (4 * (divider + 1))
+void i2c_SetDivider(unsigned char divider);
+
 // i2c_Wait - wait for I2C transfer to finish
 void i2c_Wait(void);
 
+// i2c_Errors - Return and clear the errors seen since the last call
+unsigned char i2c_Errors(void);
+
 // i2c_Start - Start I2C communication
 void i2c_Start(void);
 
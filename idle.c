@@ -0,0 +1,68 @@
+#include <xc.h>
+#include <stdbool.h>
+#include "idle.h"
+#include "backlight.h"
+#include "tick.h"
+
+static unsigned int idle_last; // Seconds timestamp of the last contact
+static unsigned char idle_level; // Level to restore on wake
+static bool idle_dimmed;
+static bool idle_swallow;
+
+void idle_init(void) {
+    idle_last = tick_seconds();
+    idle_dimmed = false;
+    idle_swallow = false;
+}
+
+/**
+ * Dim the backlight once the panel has been idle for IDLE_TIMEOUT_S
+ *
+ * Called from the main loop on each tick.
+ */
+void idle_service(void) {
+#if IDLE_TIMEOUT_S
+    if (idle_dimmed) return;
+    if ((unsigned int) (tick_seconds() - idle_last) < IDLE_TIMEOUT_S) return;
+
+    idle_level = bl_get_level();
+    idle_dimmed = true;
+    bl_fade_to(IDLE_DIM_LEVEL, IDLE_FADE_MS);
+#endif
+}
+
+/**
+ * Record touch activity from a filtered frame
+ *
+ * A touch-down while dimmed restores the previous level immediately,
+ * cancelling the idle fade if it is still running.
+ * @param pts Filtered contacts
+ * @param count Number of contacts
+ * @return true if the frame should be sent to the host
+ */
+bool idle_activity(const touch_point *pts, unsigned char count) {
+    unsigned char i;
+    bool down = false;
+
+    for (i = 0; i < count; i++) {
+        if (pts[i].event != TP_EVENT_UP) down = true;
+    }
+    if (!down) {
+        // Stop swallowing once every contact has lifted
+        if (idle_swallow) {
+            idle_swallow = false;
+            return false;
+        }
+        return true;
+    }
+
+    idle_last = tick_seconds();
+    if (idle_dimmed) {
+        idle_dimmed = false;
+        bl_level(idle_level);
+#ifdef IDLE_SWALLOW_WAKE_TOUCH
+        idle_swallow = true;
+#endif
+    }
+    return !idle_swallow;
+}
@@ -0,0 +1,45 @@
+/*
+ * File:   idle.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef IDLE_H
+#define	IDLE_H
+
+#include <stdbool.h>
+#include "touchpanel.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Seconds without a touch before the backlight is dimmed, 0 to never dim
+#ifndef IDLE_TIMEOUT_S
+#define IDLE_TIMEOUT_S  300
+#endif
+
+// Backlight level while idle, 0 turns it off
+#ifndef IDLE_DIM_LEVEL
+#define IDLE_DIM_LEVEL  0
+#endif
+
+// Length of the fade into the idle level
+#ifndef IDLE_FADE_MS
+#define IDLE_FADE_MS    2000
+#endif
+
+// Define to keep the touch that wakes the backlight from the host, so
+// tapping a dark screen does not press whatever is under the finger
+#define IDLE_SWALLOW_WAKE_TOUCH
+
+void idle_init(void);
+void idle_service(void);
+bool idle_activity(const touch_point *pts, unsigned char count);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* IDLE_H */
+
@@ -0,0 +1,65 @@
+#include <xc.h>
+#include <string.h>
+#include "latency.h"
+#include "tick.h"
+
+#if LAT_POINTS > 8
+#error "lat_valid holds one bit per point"
+#endif
+
+static unsigned int lat_stamp[LAT_POINTS];
+// Bit n set while lat_stamp[n] belongs to the current frame
+static unsigned char lat_valid;
+// Saturating counts, stage-major
+static unsigned char lat_hist[LAT_STAGES][LAT_BUCKETS];
+
+/**
+ * Timestamp a point on the touch to USB path
+ *
+ * Called from the main loop and both interrupts, so the update runs with
+ * interrupts masked. A point taken straight after the previous point of
+ * the same frame adds that stage to its histogram; LAT_T_INT starts a new
+ * frame.
+ * @param point
+ */
+void lat_mark(unsigned char point) {
+    unsigned int now = tick_fast();
+    unsigned int d;
+    unsigned char b;
+    unsigned char *h;
+    unsigned char gie = INTCON & 0x80; // GIEH, also masks low priority
+
+    INTCONbits.GIEH = 0;
+    if (point == LAT_T_INT) {
+        lat_drop();
+    } else if (lat_valid & (1 << (point - 1))) {
+        lat_valid &= ~(1 << (point - 1));
+        d = now - lat_stamp[point - 1];
+        for (b = 0; b < LAT_BUCKETS - 1 && d >= (LAT_BASE << b); b++);
+        h = &lat_hist[point - 1][b];
+        if (*h != 0xFF) (*h)++;
+    }
+    lat_stamp[point] = now;
+    lat_valid |= 1 << point;
+    INTCON |= gie;
+}
+
+/**
+ * Forget the current frame, for frames that are not sent
+ *
+ * A single byte store, so it needs no masking.
+ */
+void lat_drop(void) {
+    lat_valid = 0;
+}
+
+/**
+ * Copy out and clear the histograms
+ *
+ * Called from the USB interrupt for the latency feature report.
+ * @param out LAT_STAGES * LAT_BUCKETS bytes
+ */
+void lat_dump(unsigned char *out) {
+    memcpy(out, lat_hist, sizeof (lat_hist));
+    memset(lat_hist, 0, sizeof (lat_hist));
+}
@@ -0,0 +1,44 @@
+/*
+ * File:   latency.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef LATENCY_H
+#define	LATENCY_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Points along the touch to USB path, in order. Each stage is the time
+// from one point to the next within the same frame.
+#define LAT_T_INT           0 // INT1 edge seen
+#define LAT_T_I2C_START     1 // Frame read started
+#define LAT_T_I2C_END       2 // Frame read finished
+#define LAT_T_PACK_START    3 // Report packing started, after any wait for
+                              // the previous report to be collected
+#define LAT_T_PACK_END      4 // Report packed
+#define LAT_T_ARMED         5 // EP1 IN buffer handed to the SIE
+#define LAT_T_DONE          6 // Host collected the report
+#define LAT_POINTS          7
+#define LAT_STAGES          (LAT_POINTS - 1)
+
+// Logarithmic buckets: bucket 0 holds stages shorter than LAT_BASE Timer1
+// counts, each following bucket twice the previous, the last everything
+// longer. With 3 counts per microsecond that is <10.7us up to >=1.37ms.
+// Stages are timed with the 16-bit Timer1, so one longer than 65535 counts
+// (21.8ms) wraps and lands in a bucket for its remainder.
+#define LAT_BASE            32
+#define LAT_BUCKETS         10
+
+void lat_mark(unsigned char point);
+void lat_drop(void);
+void lat_dump(unsigned char *out);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* LATENCY_H */
+
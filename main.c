@@ -8,6 +8,16 @@
 #include <xc.h>
 #include "backlight.h"
 #include "touchpanel.h"
+#include "tick.h"
+#include "idle.h"
+#include "settings.h"
+#include "boot.h"
+#include "event.h"
+#include "power.h"
+#include "stats.h"
+#include "latency.h"
+#include "probe.h"
+#include "trace.h"
 #include "usb/usb.h"
 #include "usb/usb_device_hid.h"
 
@@ -15,68 +25,130 @@
 #define _XTAL_FREQ 48000000
 
 void interrupt_init(void);
+static void tick_tasks(void);
 
 MAIN_RETURN main()
 {
+    PROBE_INIT();
+    evt_init();
+    cfg_init();
+    tick_init();
+    TRACE_INIT();
+
     USBDeviceInit();
     USBDeviceAttach();
 
+    // Panel and backlight come up in timed steps from boot_tasks() while
+    // the USB interrupt enumerates
     bl_init();
     tp_init();
-
-    tp_enable();
-
-    bl_enable();
+    idle_init();
+    boot_init();
 
     while(1)
     {
-        /* If the USB device isn't configured yet, we can't really do anything
-         * else since we don't have a host to talk to.  So jump back to the
-         * top of the while loop. */
-        if( USBGetDeviceState() < CONFIGURED_STATE )
+        switch(evt_get())
         {
-            /* Jump back to the top of the while loop. */
-            continue;
+            case EVT_TOUCH:
+                tp_service();
+                break;
+
+            case EVT_TICK:
+                tick_tasks();
+                break;
+
+            case EVT_SOF:
+                APP_DeviceHIDDigitizerSOFHandler();
+                break;
+
+            case EVT_EEPROM:
+                cfg_tasks();
+                break;
+
+            case EVT_HOST:
+                APP_DeviceHIDDigitizerTasks();
+                break;
+
+            case EVT_SUSPEND:
+                pwr_suspend();
+                break;
+
+            case EVT_RESUME:
+                pwr_resume();
+                break;
+
+            case EVT_CONFIGURED:
+                boot_mark(BOOT_STAGE_CONFIGURED);
+                break;
+
+            default:
+                /* Nothing queued, sleep until the next interrupt.  USB
+                 * enumeration and suspend are handled entirely in the
+                 * interrupt, so there is nothing to poll.  While the bus
+                 * is suspended nothing needs the tick either, so the
+                 * oscillator is stopped as well. */
+                evt_idle(pwr_suspended());
+                break;
         }
-        /* If we are currently suspended, then we need to see if we need to
-         * issue a remote wakeup.  In either case, we shouldn't process any
-         * keyboard commands since we aren't currently communicating to the host
-         * thus just continue back to the start of the while loop. */
-        if( USBIsDeviceSuspended()== true )
-        {
-            /* Jump back to the top of the while loop. */
-            continue;
-        }
-        //Application specific tasks
-        APP_DeviceHIDDigitizerTasks();
+
+        bl_tasks();
     }//end while
 
 }
 
+/**
+ * Timed work, run once per EVT_TICK
+ *
+ * Ticks are coalesced while the main loop is busy, so fades are stepped
+ * once for every tick that elapsed since the last call.
+ */
+static void tick_tasks(void)
+{
+    static unsigned int last;
+    unsigned int now = tick_get();
+
+    while(last != now)
+    {
+        last++;
+        bl_fade_service();
+    }
+    idle_service();
+    boot_tasks();
+}
+
 bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size)
 {
     switch( (int) event )
     {
         case EVENT_TRANSFER:
+            // EP0 transactions never get here, and EP1 is the only other
+            // endpoint
+            if(USBHALGetLastDirection((*(USTAT_FIELDS*)pdata)) == IN_TO_HOST)
+            {
+                lat_mark(LAT_T_DONE);
+                PROBE_DONE();
+                TRACE(TRACE_IN_DONE, 0);
+            }
             break;
 
         case EVENT_SOF:
-            APP_DeviceHIDDigitizerSOFHandler();
+            stats.sofs++;
+            evt_post(EVT_SOF);
             break;
 
         case EVENT_SUSPEND:
+            evt_post(EVT_SUSPEND);
             break;
 
         case EVENT_RESUME:
+            evt_post(EVT_RESUME);
             break;
 
         case EVENT_CONFIGURED:
             /* When the device is configured, we can (re)initialize the
              * demo code. */
             APP_DeviceHIDDigitizerInitialize();
-            break;
-
-        case EVENT_SET_DESCRIPTOR:
+            evt_post(EVT_CONFIGURED);
             break;
 
         case EVENT_EP0_REQUEST:
@@ -86,9 +158,8 @@ bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size
             break;
 
         case EVENT_BUS_ERROR:
-            break;
-
-        case EVENT_TRANSFER_TERMINATED:
+            stats.bus_errors++;
+            TRACE(TRACE_BUS_ERR, UEIR);
             break;
 
         default:
@@ -98,16 +169,30 @@ bool USER_USB_CALLBACK_EVENT_HANDLER(USB_EVENT event, void *pdata, uint16_t size
 }
 
 void interrupt high_priority isr() {
+    unsigned int start = tick_fast();
+
+#ifndef PROBE_ENABLE
+    // Latch USB errors on RC4, which is a probe pin in probe builds
     if (UEIR) {
             TRISCbits.RC4 = 0;
             LATCbits.LATC4 = 1;
 
     }
+#endif
     // Check all USB interrupts
     USBDeviceTasks();
+    stats_isr_hi(start);
 }
 
 void interrupt low_priority isr_low() {
-    // Check touch panel interrupt
-    tp_service();
+    unsigned int start = tick_fast();
+
+    // Only flag work here, it is all done from the main loop
+    if (tick_service()) {
+        evt_post(EVT_TICK);
+    }
+    tp_isr();
+    cfg_isr();
+    TRACE_ISR();
+    stats_isr_lo(start);
 }
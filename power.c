@@ -0,0 +1,81 @@
+#include <xc.h>
+#include <stdbool.h>
+#include "power.h"
+#include "backlight.h"
+#include "touchpanel.h"
+#include "tick.h"
+#include "trace.h"
+#include "usb/usb.h"
+
+static bool pwr_asleep;
+static bool pwr_waking; // Remote wakeup signalled, waiting for resume
+static unsigned int pwr_since; // Tick the suspend was handled
+
+/**
+ * Park the panel and backlight while the host has the bus suspended
+ *
+ * Called from the main loop for EVT_SUSPEND. The controller is kept
+ * scanning in monitor mode if the host allows remote wakeup, so a touch
+ * can wake it; otherwise it is put into hibernation. Until the bus resumes
+ * the main loop idles in SLEEP, see evt_idle().
+ */
+void pwr_suspend(void) {
+    // Events are coalesced, so act on the bus state rather than the order
+    if (pwr_asleep || !USBIsBusSuspended()) return;
+    pwr_asleep = true;
+    pwr_waking = false;
+    TRACE(TRACE_SUSPEND, 0);
+    pwr_since = tick_get();
+
+    bl_disable();
+    tp_suspend(USBGetRemoteWakeupStatus());
+}
+
+/**
+ * Bring the panel and backlight back after the bus resumes
+ *
+ * Called from the main loop for EVT_RESUME. Any touch that triggered the
+ * wakeup is sent to the host from tp_resume().
+ */
+void pwr_resume(void) {
+    if (!pwr_asleep || USBIsBusSuspended()) return;
+    pwr_asleep = false;
+    pwr_waking = false;
+    TRACE(TRACE_RESUME, 0);
+
+    bl_enable();
+    tp_resume();
+}
+
+bool pwr_suspended(void) {
+    return pwr_asleep;
+}
+
+/**
+ * Signal remote wakeup to the host
+ *
+ * Does nothing unless the host enabled remote wakeup, and only signals once
+ * per suspend. Blocks for the length of the resume signalling.
+ */
+void pwr_remote_wakeup(void) {
+    unsigned char i;
+    unsigned int start;
+
+    if (!pwr_asleep || pwr_waking) return;
+    if (!USBGetRemoteWakeupStatus() || !USBIsBusSuspended()) return;
+    pwr_waking = true;
+
+    while ((unsigned int) (tick_get() - pwr_since) < PWR_WAKE_IDLE_MS);
+
+    // The stack must not see its own resume signalling as bus activity
+    USBMaskInterrupts();
+    USBSuspendControl = 0;
+    USBResumeControl = 1;
+    for (i = 0; i < PWR_RESUME_MS; i++) {
+        start = tick_fast();
+        while ((unsigned int) (tick_fast() - start) < 1000 * TICK_FAST_PER_US);
+    }
+    USBResumeControl = 0;
+    USBUnmaskInterrupts();
+    TRACE(TRACE_WAKEUP, 0);
+}
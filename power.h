@@ -0,0 +1,32 @@
+/*
+ * File:   power.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef POWER_H
+#define	POWER_H
+
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Bus idle required before remote wakeup signalling, counted from the
+// suspend event which itself follows 3ms of idle (USB 2.0 7.1.7.7)
+#define PWR_WAKE_IDLE_MS    3
+// Length of the resume signalling, 1ms to 15ms
+#define PWR_RESUME_MS       10
+
+void pwr_suspend(void);
+void pwr_resume(void);
+bool pwr_suspended(void);
+void pwr_remote_wakeup(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* POWER_H */
+
@@ -0,0 +1,52 @@
+/*
+ * File:   probe.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef PROBE_H
+#define	PROBE_H
+
+#include <xc.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Define to drive two spare pins at points along the touch to USB path, for
+// timing with a logic analyzer (see tools/probe_latency.py). Each probe is a
+// single bit set or clear. Undefined, the macros expand to nothing.
+//#define PROBE_ENABLE
+
+// RC4 and RC6 are not connected on the board. RC3 would be easier to reach
+// on the programming header but is the PGM pin while LVP is enabled.
+//
+// Probe A rises when INT1 is seen and falls when the frame is decoded.
+// Probe B rises when the report is armed and falls when the host collects
+// it. A frame that is not sent has no probe B pulse.
+#ifdef PROBE_ENABLE
+#define PROBE_INIT()        do { \
+                                ANSELHbits.ANS8 = 0; \
+                                LATCbits.LATC4 = 0; \
+                                LATCbits.LATC6 = 0; \
+                                TRISCbits.TRISC4 = 0; \
+                                TRISCbits.TRISC6 = 0; \
+                            } while (0)
+#define PROBE_INT()         (LATCbits.LATC4 = 1)
+#define PROBE_DECODED()     (LATCbits.LATC4 = 0)
+#define PROBE_ARMED()       (LATCbits.LATC6 = 1)
+#define PROBE_DONE()        (LATCbits.LATC6 = 0)
+#else
+#define PROBE_INIT()
+#define PROBE_INT()
+#define PROBE_DECODED()
+#define PROBE_ARMED()
+#define PROBE_DONE()
+#endif
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* PROBE_H */
+
@@ -0,0 +1,188 @@
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "settings.h"
+#include "filter.h"
+#include "transform.h"
+#include "event.h"
+#include "trace.h"
+
+#define CFG_NONE    0xFF
+
+cfg_settings cfg;
+
+static unsigned char cfg_slot; // Slot holding the newest block, or CFG_NONE
+static unsigned char cfg_seq;
+
+// Save in progress: snapshot of the block and the next byte to write
+static cfg_block cfg_out;
+static unsigned char cfg_out_addr;
+static unsigned char cfg_out_pos;
+static bool cfg_writing;
+static bool cfg_dirty;
+
+static const cfg_settings cfg_defaults = {
+    { 4096, 0, 0, 0, 4096, 0 },
+    0,
+    FLT_DOWN_FRAMES,
+    FLT_MAX_JUMP,
+    FLT_JUMP_FRAMES,
+    0xFF,
+    39
+};
+
+/**
+ * CRC-16/CCITT, polynomial 0x1021
+ */
+static unsigned int cfg_crc(const unsigned char *p, unsigned char len) {
+    unsigned int crc = 0xFFFF;
+    unsigned char i;
+
+    while (len--) {
+        crc ^= (unsigned int) *p++ << 8;
+        for (i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void cfg_read_block(unsigned char addr, cfg_block *b) {
+    unsigned char *p = (unsigned char *) b;
+    unsigned char i;
+
+    for (i = 0; i < sizeof (cfg_block); i++) {
+        p[i] = eeprom_read(addr + i);
+    }
+}
+
+static bool cfg_valid(const cfg_block *b) {
+    return b->version == CFG_VERSION
+            && b->crc == cfg_crc((const unsigned char *) b,
+            sizeof (cfg_block) - sizeof (b->crc));
+}
+
+/**
+ * Load the newest valid block into the RAM shadow
+ *
+ * Called once at boot, before any module reads cfg. A blank or corrupt
+ * EEPROM gives the compiled-in defaults.
+ */
+void cfg_init(void) {
+    cfg_block b;
+    unsigned char i;
+
+    PIR2bits.EEIF = 0;
+    IPR2bits.EEIP = 0; // Low priority
+    PIE2bits.EEIE = 1;
+
+    cfg = cfg_defaults;
+    cfg_slot = CFG_NONE;
+    cfg_seq = 0;
+
+    for (i = 0; i < CFG_SLOTS; i++) {
+        cfg_read_block(i * CFG_SLOT_SIZE, &b);
+        // A block that fails cfg_check() falls back to an older one
+        if (!cfg_valid(&b) || !cfg_check(&b.settings)) continue;
+        // Sequence numbers wrap, so compare them as a signed difference
+        if (cfg_slot == CFG_NONE || (signed char) (b.seq - cfg_seq) > 0) {
+            cfg_slot = i;
+            cfg_seq = b.seq;
+            cfg = b.settings;
+        }
+    }
+}
+
+/**
+ * Check settings from the host before they are applied and stored
+ *
+ * Anything that could stop the panel working, and so keep the host from
+ * ever correcting it, is refused.
+ * @param s
+ * @return
+ */
+bool cfg_check(const cfg_settings *s) {
+    if (s->flt_down_frames < 1 || s->flt_down_frames > CFG_FLT_FRAMES_MAX)
+        return false;
+    if (s->flt_jump_frames < 1 || s->flt_jump_frames > CFG_FLT_FRAMES_MAX)
+        return false;
+    if (s->flt_max_jump == 0) return false;
+    if (s->i2c_sspadd < CFG_I2C_SSPADD_MIN) return false;
+    if ((s->tf_flags & CFG_TF_CALIBRATED) && !tf_check(s->tf_matrix))
+        return false;
+    return true;
+}
+
+/**
+ * Schedule the RAM shadow to be written to EEPROM
+ *
+ * The write is carried out a byte at a time by cfg_tasks(), so this is
+ * safe to call from anywhere but an interrupt.
+ */
+void cfg_save(void) {
+    cfg_dirty = true;
+    evt_post(EVT_EEPROM);
+}
+
+bool cfg_busy(void) {
+    return cfg_dirty || cfg_writing;
+}
+
+/**
+ * Advance a pending save
+ *
+ * Called from the main loop for EVT_EEPROM. Each call starts at most one
+ * EEPROM byte write and returns while the cell is programming, so neither the touch
+ * nor the USB interrupt ever waits on the EEPROM. The CRC is written
+ * last; a block cut short by a reset fails its check and the previous
+ * slot is used instead.
+ */
+void cfg_tasks(void) {
+    unsigned char b;
+
+    if (EECON1bits.WR) return;
+
+    if (!cfg_writing) {
+        if (!cfg_dirty) return;
+        cfg_dirty = false;
+
+        cfg_out.version = CFG_VERSION;
+        cfg_out.seq = cfg_seq + 1;
+        cfg_out.settings = cfg;
+        cfg_out.crc = cfg_crc((const unsigned char *) &cfg_out,
+                sizeof (cfg_block) - sizeof (cfg_out.crc));
+
+        cfg_slot = (cfg_slot == CFG_NONE) ? 0 : (cfg_slot + 1) % CFG_SLOTS;
+        cfg_out_addr = cfg_slot * CFG_SLOT_SIZE;
+        cfg_out_pos = 0;
+        cfg_writing = true;
+    }
+
+    // Skip cells that already hold the right value
+    while (cfg_out_pos < sizeof (cfg_block)) {
+        b = ((unsigned char *) &cfg_out)[cfg_out_pos];
+        if (eeprom_read(cfg_out_addr + cfg_out_pos) != b) {
+            eeprom_write(cfg_out_addr + cfg_out_pos, b);
+            cfg_out_pos++;
+            return;
+        }
+        cfg_out_pos++;
+    }
+
+    cfg_seq = cfg_out.seq;
+    cfg_writing = false;
+    TRACE(TRACE_CFG_SAVE, cfg_slot);
+    // Settings changed while this block was being written
+    if (cfg_dirty) evt_post(EVT_EEPROM);
+}
+
+/**
+ * Signal the end of an EEPROM write cycle
+ *
+ * Called from the low-priority interrupt.
+ */
+void cfg_isr(void) {
+    if (!PIR2bits.EEIF) return;
+    PIR2bits.EEIF = 0;
+    evt_post(EVT_EEPROM);
+}
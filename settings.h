@@ -0,0 +1,69 @@
+/*
+ * File:   settings.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SETTINGS_H
+#define	SETTINGS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Bump when cfg_settings changes layout. Blocks with another version are
+// ignored and the defaults are used.
+#define CFG_VERSION     1
+
+// The data EEPROM is split into equal slots and each save goes to the slot
+// after the newest one, spreading wear over all of them.
+#define CFG_EEPROM_SIZE 256
+#define CFG_SLOT_SIZE   32
+#define CFG_SLOTS       (CFG_EEPROM_SIZE / CFG_SLOT_SIZE)
+
+// cfg_settings.tf_flags
+#define CFG_TF_CALIBRATED   0x01
+
+// Limits on settings from the host, see cfg_check()
+#define CFG_FLT_FRAMES_MAX  16
+#define CFG_I2C_SSPADD_MIN  29 // 400kHz, the fastest the controller takes
+
+// Runtime tunables. This is also the payload of the configuration feature
+// report, so fields are only ever appended.
+typedef struct {
+    int16_t tf_matrix[6]; // Calibration, see transform.h
+    unsigned char tf_flags;
+    unsigned char flt_down_frames;
+    unsigned int flt_max_jump;
+    unsigned char flt_jump_frames;
+    unsigned char bl_level; // Power-on backlight level
+    unsigned char i2c_sspadd; // I2C clock = FOSC / (4 * (SSPADD + 1))
+} cfg_settings;
+
+// Stored block: version and sequence number, settings, CRC-16 over both
+typedef struct {
+    unsigned char version;
+    unsigned char seq;
+    cfg_settings settings;
+    unsigned int crc;
+} cfg_block;
+
+// RAM shadow, loaded by cfg_init()
+extern cfg_settings cfg;
+
+void cfg_init(void);
+bool cfg_check(const cfg_settings *s);
+void cfg_save(void);
+bool cfg_busy(void);
+void cfg_tasks(void);
+void cfg_isr(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SETTINGS_H */
+
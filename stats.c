@@ -0,0 +1,46 @@
+#include <xc.h>
+#include "stats.h"
+#include "tick.h"
+#include "i2c.h"
+#include "trace.h"
+
+stats_counters stats;
+
+// Moving averages, scaled by 16
+static unsigned int stats_hi_avg;
+static unsigned int stats_lo_avg;
+
+/**
+ * Account for one high-priority interrupt
+ * @param start tick_fast() on entry
+ */
+void stats_isr_hi(unsigned int start) {
+    unsigned int d = tick_fast() - start;
+
+    if (d > stats.isr_hi_max) stats.isr_hi_max = d;
+    stats.isr_hi_total += d;
+    stats_hi_avg += d - (stats_hi_avg >> 4);
+    stats.isr_hi_mean = stats_hi_avg >> 4;
+}
+
+/**
+ * Account for one low-priority interrupt
+ * @param start tick_fast() on entry
+ */
+void stats_isr_lo(unsigned int start) {
+    unsigned int d = tick_fast() - start;
+
+    if (d > stats.isr_lo_max) stats.isr_lo_max = d;
+    stats_lo_avg += d - (stats_lo_avg >> 4);
+    stats.isr_lo_mean = stats_lo_avg >> 4;
+}
+
+/**
+ * Count errors from an I2C transaction
+ * @param errors Flags from i2c_Errors()
+ */
+void stats_i2c(unsigned char errors) {
+    if (errors & I2C_ERR_TIMEOUT) stats.i2c_timeouts++;
+    if (errors & I2C_ERR_NAK) stats.i2c_naks++;
+    if (errors) TRACE(TRACE_I2C_ERR, errors);
+}
@@ -0,0 +1,53 @@
+/*
+ * File:   stats.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef STATS_H
+#define	STATS_H
+
+#include "touchpanel.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Runtime counters, also the payload of the counters feature report. All
+// counters wrap. ISR durations are in Timer1 counts (TICK_FAST_PER_US per
+// microsecond) and the means are exponential moving averages over roughly
+// the last 16 interrupts.
+typedef struct {
+    unsigned long frames; // Frames read from the controller
+    unsigned long reports; // Input reports sent
+    unsigned long sofs; // USB start of frame packets
+    unsigned int dropped; // Frames with contacts that were not sent
+    unsigned int coalesced; // Frames signalled while one was being read
+    unsigned int i2c_timeouts;
+    unsigned int i2c_naks;
+    unsigned int bus_errors; // USB EVENT_BUS_ERROR
+    unsigned int isr_hi_max; // High priority (USB) interrupt
+    unsigned int isr_hi_mean;
+    unsigned int isr_lo_max; // Low priority interrupt
+    unsigned int isr_lo_mean;
+    unsigned long isr_hi_total; // All high priority interrupts, for the
+                                // load per SOF compared against sofs
+#ifdef TP_PACK_BENCH
+    // Instruction cycles averaged over roughly the last 16 frames, except
+    // TP_BENCH_MISMATCH which counts frames
+    unsigned int bench[TP_BENCHES];
+#endif
+} stats_counters;
+
+extern stats_counters stats;
+
+void stats_isr_hi(unsigned int start);
+void stats_isr_lo(unsigned int start);
+void stats_i2c(unsigned char errors);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* STATS_H */
+
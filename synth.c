@@ -0,0 +1,152 @@
+#include <xc.h>
+#include <stdbool.h>
+#include "synth.h"
+#include "touchpanel.h"
+#include "transform.h"
+#include "latency.h"
+
+#define SYN_AREA        3 // Finger sized, well below TP_PALM_AREA
+#define SYN_PINCH_GAP   40 // Closest the pinch contacts get to the centre
+
+static touch_point syn_pts[TP_MAX_POINTS];
+static unsigned char syn_script;
+static unsigned char syn_contacts;
+static unsigned int syn_frames;
+static unsigned int syn_step;
+static bool syn_down; // Contacts were down in the last frame sent
+
+// Requested by the host, taken up once any contacts have been lifted
+static syn_control syn_next;
+static bool syn_restart;
+
+/**
+ * Start a script, or stop with SYN_OFF
+ *
+ * Called from the main loop with the feature report payload. Contacts
+ * left down by the running script are lifted first.
+ * @param ctl
+ */
+void syn_start(const syn_control *ctl) {
+    syn_next = *ctl;
+    if (syn_next.script >= SYN_SCRIPTS) syn_next.script = SYN_OFF;
+    if (syn_next.contacts < 1) syn_next.contacts = 1;
+    if (syn_next.contacts > TP_MAX_POINTS) syn_next.contacts = TP_MAX_POINTS;
+    if (syn_next.script == SYN_PINCH) syn_next.contacts = 2;
+    syn_restart = true;
+}
+
+void syn_get(syn_control *ctl) {
+    ctl->script = syn_script;
+    ctl->contacts = syn_contacts;
+    ctl->frames = syn_frames;
+}
+
+/**
+ * Synthetic frames are being sent, or contacts still need lifting
+ * @return
+ */
+bool syn_active(void) {
+    return syn_script != SYN_OFF || syn_restart;
+}
+
+// Triangle wave from 0 up to max and back, for positions that bounce
+// between the panel edges
+static unsigned int syn_tri(unsigned long v, unsigned int max) {
+    v %= 2UL * max;
+    return (v <= max) ? (unsigned int) v : (unsigned int) (2UL * max - v);
+}
+
+static void syn_frame(void) {
+    unsigned char i;
+    unsigned char n = syn_contacts;
+    unsigned char event = syn_down ? TP_EVENT_CONTACT : TP_EVENT_DOWN;
+    unsigned int lane;
+    unsigned int tap;
+    unsigned int d;
+    touch_point *pt;
+
+    if (syn_script == SYN_TAP
+            && syn_step % (SYN_TAP_FRAMES + 1) == SYN_TAP_FRAMES) {
+        event = TP_EVENT_UP;
+    }
+
+    for (i = 0; i < n; i++) {
+        pt = &syn_pts[i];
+        pt->id = i;
+        pt->event = event;
+        pt->area = SYN_AREA;
+
+        switch (syn_script) {
+            case SYN_TAP:
+                // Each contact taps within its own strip of the panel
+                lane = TF_X_MAX / n;
+                tap = syn_step / (SYN_TAP_FRAMES + 1);
+                pt->x = lane * i + (tap * SYN_SPEED) % lane;
+                pt->y = TF_Y_MAX / 2;
+                break;
+
+            case SYN_SWIPE:
+                lane = TF_Y_MAX / n;
+                pt->x = syn_tri((unsigned long) syn_step * SYN_SPEED, TF_X_MAX);
+                pt->y = lane * i + lane / 2;
+                break;
+
+            case SYN_PINCH:
+                d = SYN_PINCH_GAP + syn_tri((unsigned long) syn_step
+                        * (SYN_SPEED / 2), TF_X_MAX / 2 - SYN_PINCH_GAP);
+                pt->x = i ? TF_X_MAX / 2 + d : TF_X_MAX / 2 - d;
+                pt->y = TF_Y_MAX / 2;
+                break;
+
+            case SYN_BOUNCE:
+                pt->x = syn_tri((unsigned long) syn_step * (SYN_SPEED + 2 * i)
+                        + 150 * i, TF_X_MAX);
+                pt->y = syn_tri((unsigned long) syn_step * (SYN_SPEED / 2 + 3 * i)
+                        + 90 * i, TF_Y_MAX);
+                break;
+        }
+    }
+
+    syn_down = (event != TP_EVENT_UP);
+}
+
+/**
+ * Send the next synthetic frame
+ *
+ * Called from the main loop once the previous input report has been
+ * collected, so frames go out at the rate the host polls. Frames are
+ * packed by tp_send() exactly like frames from the panel.
+ */
+void syn_service(void) {
+    unsigned char i;
+
+    // There was no panel read, only time these from packing
+    lat_drop();
+
+    if (syn_restart) {
+        if (syn_down) {
+            for (i = 0; i < syn_contacts; i++) {
+                syn_pts[i].event = TP_EVENT_UP;
+            }
+            tp_send(syn_pts, syn_contacts);
+            syn_down = false;
+            return;
+        }
+        syn_restart = false;
+        syn_script = syn_next.script;
+        syn_contacts = syn_next.contacts;
+        syn_frames = syn_next.frames;
+        syn_step = 0;
+    }
+    if (syn_script == SYN_OFF) return;
+
+    syn_frame();
+    tp_send(syn_pts, syn_contacts);
+    syn_step++;
+
+    // Lift and stop once the requested number of frames has gone out
+    if (syn_frames && !--syn_frames) {
+        syn_next.script = SYN_OFF;
+        syn_restart = true;
+    }
+}
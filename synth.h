@@ -0,0 +1,51 @@
+/*
+ * File:   synth.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef SYNTH_H
+#define	SYNTH_H
+
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Scripts, selected through the synthetic touch feature report
+#define SYN_OFF         0
+#define SYN_TAP         1 // Contacts tap together, moving along a little
+                          // with each tap
+#define SYN_SWIPE       2 // Contacts sweep across the panel and back
+#define SYN_PINCH       3 // Two contacts spread apart and close again
+#define SYN_BOUNCE      4 // Contacts bounce around the panel at different
+                          // speeds, so every coordinate changes each frame
+#define SYN_SCRIPTS     5
+
+// Movement per frame, in report units
+#ifndef SYN_SPEED
+#define SYN_SPEED       8
+#endif
+
+// Frames each contact stays down for SYN_TAP
+#define SYN_TAP_FRAMES  8
+
+// Payload of the synthetic touch feature report
+typedef struct {
+    unsigned char script; // SYN_*, SYN_OFF stops
+    unsigned char contacts; // 1 to TP_MAX_POINTS, SYN_PINCH always uses 2
+    unsigned int frames; // Frames left to send, 0 runs until stopped
+} syn_control;
+
+void syn_start(const syn_control *ctl);
+void syn_get(syn_control *ctl);
+bool syn_active(void);
+void syn_service(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* SYNTH_H */
+
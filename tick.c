@@ -0,0 +1,89 @@
+#include <xc.h>
+#include "tick.h"
+
+static volatile unsigned int tick_ms;
+static volatile unsigned int tick_s;
+static unsigned int tick_sub;
+
+void tick_init(void) {
+    T0CON = 0b00000010; // 16-bit, internal clock, 1:8 prescaler, stopped
+    TMR0H = TICK_RELOAD >> 8;
+    TMR0L = TICK_RELOAD & 0xFF;
+    INTCON2bits.TMR0IP = 0; // Low priority
+    INTCONbits.TMR0IF = 0;
+    INTCONbits.TMR0IE = 1;
+    T0CONbits.TMR0ON = 1;
+
+    T1CON = 0b10100001; // 16-bit reads, 1:4 prescaler, FOSC/4, on
+}
+
+/**
+ * Advance the tick if Timer0 has rolled over
+ *
+ * Called from the low-priority interrupt. The main loop is told through
+ * EVT_TICK and catches up on however many ticks elapsed.
+ * @return true if a tick elapsed
+ */
+bool tick_service(void) {
+    if (!INTCONbits.TMR0IF) return false;
+
+    TMR0H = TICK_RELOAD >> 8;
+    TMR0L = TICK_RELOAD & 0xFF;
+    INTCONbits.TMR0IF = 0;
+    tick_ms++;
+    if (++tick_sub >= TICK_HZ) {
+        tick_sub = 0;
+        tick_s++;
+    }
+    return true;
+}
+
+/**
+ * Milliseconds since tick_init(), wrapping every 65.5 seconds
+ *
+ * The Timer0 interrupt is masked for the read and left as it was found, so
+ * a call that interrupts another read cannot unmask it early.
+ * @return
+ */
+unsigned int tick_get(void) {
+    unsigned char tmr0ie = INTCONbits.TMR0IE;
+    unsigned int t;
+
+    INTCONbits.TMR0IE = 0;
+    t = tick_ms;
+    INTCONbits.TMR0IE = tmr0ie;
+    return t;
+}
+
+/**
+ * Seconds since tick_init(), wrapping after about 18 hours
+ * @return
+ */
+unsigned int tick_seconds(void) {
+    unsigned char tmr0ie = INTCONbits.TMR0IE;
+    unsigned int t;
+
+    INTCONbits.TMR0IE = 0;
+    t = tick_s;
+    INTCONbits.TMR0IE = tmr0ie;
+    return t;
+}
+
+/**
+ * Free-running Timer1 count, TICK_FAST_PER_US counts per microsecond
+ *
+ * Safe to call from either interrupt. Interrupts are held off between the
+ * two reads so an interrupt reading the timer cannot replace the latched
+ * high byte.
+ * @return
+ */
+unsigned int tick_fast(void) {
+    unsigned char gieh = INTCONbits.GIEH;
+    unsigned int t;
+
+    INTCONbits.GIEH = 0;
+    t = TMR1L; // Latches TMR1H
+    t |= (unsigned int) TMR1H << 8;
+    INTCONbits.GIEH = gieh;
+    return t;
+}
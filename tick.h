@@ -0,0 +1,34 @@
+/*
+ * File:   tick.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TICK_H
+#define	TICK_H
+
+#include <stdbool.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+#define TICK_HZ         1000
+// Timer0 reload for one tick at FOSC/4 = 12MHz with a 1:8 prescaler
+#define TICK_RELOAD     (65536 - 12000000 / 8 / TICK_HZ)
+
+// Free-running Timer1 at FOSC/4 with a 1:4 prescaler
+#define TICK_FAST_PER_US    3
+
+void tick_init(void);
+bool tick_service(void);
+unsigned int tick_get(void);
+unsigned int tick_seconds(void);
+unsigned int tick_fast(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TICK_H */
+
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Time from enumeration to a usable touch device, on Linux.
+
+The board is taken off the bus and back through its sysfs 'authorized'
+attribute, which makes the host read the configuration again, bind the HID
+driver (fetching the report descriptor) and create the input devices.
+Each run is timed from re-authorizing to the last input device node
+appearing. Needs root.
+
+    sudo enum_bench.py -n 20
+
+With --replug the board is unplugged and plugged in by hand instead, and
+each run is timed from the USB device appearing, so bus reset and address
+assignment are included as well.
+"""
+
+import argparse
+import glob
+import os
+import statistics
+import sys
+import time
+
+SYS = '/sys/bus/usb/devices'
+
+
+def find_device(vid, pid):
+    for path in glob.glob(os.path.join(SYS, '*')):
+        try:
+            with open(os.path.join(path, 'idVendor')) as f:
+                v = int(f.read(), 16)
+            with open(os.path.join(path, 'idProduct')) as f:
+                p = int(f.read(), 16)
+        except (OSError, ValueError):
+            continue
+        if (v, p) == (vid, pid):
+            return path
+    return None
+
+
+def read(path, default=None):
+    try:
+        with open(path) as f:
+            return f.read().strip()
+    except OSError:
+        return default
+
+
+def inputs(dev):
+    return glob.glob(os.path.join(dev, '*:1.0', '*', 'input', 'input*'))
+
+
+def wait(cond, timeout):
+    end = time.monotonic() + timeout
+    while time.monotonic() < end:
+        r = cond()
+        if r:
+            return r
+        time.sleep(0.0005)
+    return None
+
+
+def settle(dev, want, quiet=0.05, timeout=5.0):
+    """Wait until the input device count reaches want and stays there."""
+    last = None
+    since = time.monotonic()
+    end = since + timeout
+    while time.monotonic() < end:
+        n = len(inputs(dev))
+        now = time.monotonic()
+        if n != last:
+            last, since = n, now
+            if n >= want:
+                stamp = now
+        elif n >= want and now - since >= quiet:
+            return stamp
+        time.sleep(0.0005)
+    return None
+
+
+def describe(dev):
+    ep0 = read(os.path.join(dev, 'bMaxPacketSize0'), '?')
+    rd = glob.glob(os.path.join(dev, '*:1.0', '*', 'report_descriptor'))
+    size = None
+    if rd:
+        # sysfs reports the attribute size as the maximum, read it instead
+        with open(rd[0], 'rb') as f:
+            size = len(f.read())
+    print('EP0 max packet %s bytes' % ep0)
+    if size and ep0.isdigit():
+        print('report descriptor %d bytes, %d IN transactions'
+              % (size, -(-size // int(ep0))))
+    print('%d input devices' % len(inputs(dev)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('-n', type=int, default=10, help='runs (default 10)')
+    ap.add_argument('--vid', type=lambda s: int(s, 16), default=0x04D8)
+    ap.add_argument('--pid', type=lambda s: int(s, 16), default=0x0063)
+    ap.add_argument('--replug', action='store_true',
+                    help='time manual unplug/plug cycles instead')
+    args = ap.parse_args()
+
+    dev = find_device(args.vid, args.pid)
+    if not dev:
+        sys.exit('device %04x:%04x not found' % (args.vid, args.pid))
+    describe(dev)
+    want = len(inputs(dev))
+    if not want:
+        sys.exit('no input devices bound, is the HID driver loaded?')
+
+    times = []
+    for i in range(args.n):
+        if args.replug:
+            print('unplug the board', end='', flush=True)
+            wait(lambda: not os.path.exists(dev), 60)
+            print(', plug it back in', flush=True)
+            dev = wait(lambda: find_device(args.vid, args.pid), 60)
+            if not dev:
+                sys.exit('device did not come back')
+            t0 = time.monotonic()
+        else:
+            auth = os.path.join(dev, 'authorized')
+            with open(auth, 'w') as f:
+                f.write('0')
+            wait(lambda: not inputs(dev), 5)
+            time.sleep(0.2)
+            t0 = time.monotonic()
+            with open(auth, 'w') as f:
+                f.write('1')
+
+        t1 = settle(dev, want)
+        if t1 is None:
+            print('run %d: timed out' % (i + 1))
+            continue
+        times.append((t1 - t0) * 1000)
+        print('run %d: %.1f ms' % (i + 1, times[-1]))
+
+    if times:
+        print('min %.1f  median %.1f  mean %.1f  max %.1f ms' % (
+            min(times), statistics.median(times), statistics.mean(times),
+            max(times)))
+
+
+if __name__ == '__main__':
+    main()
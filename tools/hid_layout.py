@@ -0,0 +1,781 @@
+#!/usr/bin/env python3
+"""Generate the HID report descriptor and report packing offsets.
+
+The reports are described once, in the table below. From it this writes
+
+  - the hid_rpt01 initializer in usb_descriptors.c, with the data format
+    diagrams above each input report, and
+  - hid_layout.h, with HID_RPT01_SIZE and the TP_RPT_* offsets, masks and
+    lengths used by the packing code in touchpanel.c.
+
+Global items are only emitted where the value in force has to change, and
+PUSH/POP is not used, so collections inherit whatever the one above them
+left behind. Fields are unitless with no physical extent unless they say
+otherwise, and the positional fields that set units sit inside Push, so the
+counts, flags and settings after them need not clear the units again.
+None inherits the value in force.
+
+    hid_layout.py           regenerate both files
+    hid_layout.py --check   exit 1 if either file is out of date, or if the
+                            descriptor in usb_descriptors.c does not parse
+                            to the layout the table describes
+
+Report IDs and TP_MAX_POINTS are read from usb_config.h and touchpanel.h,
+and HID_INT_IN_EP_SIZE bounds the input report lengths.
+"""
+
+import argparse
+import difflib
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.join(HERE, '..')
+DESCRIPTORS = os.path.join(ROOT, 'usb_descriptors.c')
+HEADER = os.path.join(ROOT, 'hid_layout.h')
+USB_CONFIG = os.path.join(ROOT, 'usb_config.h')
+TOUCHPANEL = os.path.join(ROOT, 'touchpanel.h')
+
+# Usage pages and the usages used from each
+DIG, GD, BTN, MON, VESA, VEN = 0x0d, 0x01, 0x09, 0x80, 0x82, 0xff00
+PAGES = {
+    DIG: 'Digitizers',
+    GD: 'Generic Desktop',
+    BTN: 'Button',
+    MON: 'Monitor',
+    VESA: 'VESA Virtual Controls',
+    VEN: 'Vendor Defined Page 1',
+}
+USAGES = {
+    DIG: {
+        0x04: 'Touch Screen', 0x0e: 'Device Configuration', 0x22: 'Finger',
+        0x23: 'Device Settings', 0x32: 'In Range', 0x42: 'Tip Switch',
+        0x47: 'Confidence', 0x48: 'Width', 0x49: 'Height',
+        0x51: 'Contact Identifier', 0x52: 'Device Mode',
+        0x53: 'Device Identifier', 0x54: 'Contact Count',
+        0x55: 'Contact Count Maximum',
+    },
+    GD: {0x01: 'Pointer', 0x02: 'Mouse', 0x30: 'X', 0x31: 'Y'},
+    MON: {0x01: 'Monitor Control'},
+    VESA: {0x10: 'Brightness'},
+}
+UNITS = {0x00: 'None', 0x33: 'Eng Lin:0x33'}
+
+APPLICATION, LOGICAL, PHYSICAL = 0x01, 0x02, 0x00
+COLLECTIONS = {APPLICATION: 'Application', LOGICAL: 'Logical',
+               PHYSICAL: 'Physical'}
+INPUT, FEATURE = 0x80, 0xb0
+DATA, CNST = 0x02, 0x03
+
+
+def usage_name(page, usage):
+    if page == BTN:
+        return 'Button %d' % usage
+    if page == VEN:
+        return 'Vendor Usage %d' % usage
+    return USAGES[page][usage]
+
+
+def U(page, name):
+    """Usage by name, as (page, id)"""
+    if page == VEN:
+        return page, int(name.split()[-1])
+    for usage, n in USAGES[page].items():
+        if n == name:
+            return page, usage
+    raise KeyError(name)
+
+
+class Sym(object):
+    """A C expression in the descriptor, encoded in width bytes.
+
+    value is only used to parse the descriptor back; leave it None where it
+    does not change the layout."""
+
+    def __init__(self, name, width, value=None):
+        self.name, self.width, self.value = name, width, value
+
+
+class Field(object):
+    """A main item, count fields of size bits each.
+
+    usages has one usage per field, a (page, min, max) range, or is empty
+    for padding. name names the fields in hid_layout.h: a string, or one
+    per usage. Fields narrower than a byte get a mask (one bit) or a shift
+    define, and byte names the byte that holds them."""
+
+    def __init__(self, kind, usages, size, count=None, lmin=0, lmax=None,
+                 pmax=0, unit=0, uexp=0, flags=DATA, name=None,
+                 byte=None, label=None):
+        self.kind, self.usages, self.size = kind, usages, size
+        if count is None:
+            count = len(usages)
+        self.count, self.lmin, self.lmax = count, lmin, lmax
+        self.pmax, self.unit, self.uexp = pmax, unit, uexp
+        self.flags, self.byte = flags, byte
+        n = count if isinstance(count, int) else 1
+        self.names = name if isinstance(name, tuple) else (name,) * n
+        self.labels = label if isinstance(label, tuple) else (label,) * n
+
+
+class Collection(object):
+    def __init__(self, kind, usage, items, diagram=None):
+        self.kind, self.usage, self.items = kind, usage, items
+        self.diagram = diagram
+
+
+class Array(object):
+    """items repeated n times, named NAME in hid_layout.h"""
+
+    def __init__(self, n, name, items):
+        self.n, self.name, self.items = n, name, items
+
+
+class Push(object):
+    """items between PUSH and POP, so the globals they set do not leak into
+    the fields that follow"""
+
+    def __init__(self, items):
+        self.items = items
+
+
+class ReportId(object):
+    """Following fields belong to the report with this usb_config.h id.
+    Input reports given a prefix get TP_RPT_<prefix>_* defines."""
+
+    def __init__(self, define, prefix=None):
+        self.define, self.prefix = define, prefix
+
+
+def table(max_points):
+    x = Field(INPUT, [U(GD, 'X')], 16, lmax=Sym('TF_X_MAX', 2),
+              pmax=Sym('TF_X_PHYS_MAX', 2), unit=0x33, uexp=-2, name='X')
+    y = Field(INPUT, [U(GD, 'Y')], 16, lmax=Sym('TF_Y_MAX', 2),
+              pmax=Sym('TF_Y_PHYS_MAX', 2), unit=0x33, uexp=-2, name='Y')
+    finger = Collection(LOGICAL, U(DIG, 'Finger'), [
+        Field(INPUT, [U(DIG, 'Tip Switch'), U(DIG, 'In Range'),
+                      U(DIG, 'Confidence')], 1, lmax=1,
+              name=('TIP', 'RANGE', 'CONFIDENCE'), byte='FLAGS',
+              label=('Tip', 'Range', 'Conf')),
+        Field(INPUT, [U(DIG, 'Contact Identifier')], 5, lmax=31, name='ID'),
+        Push([
+            x, y,
+            Field(INPUT, [U(DIG, 'Width'), U(DIG, 'Height')], 8, lmax=255,
+                  pmax=Sym('TP_SIZE_PHYS_MAX', 2), unit=0x33, uexp=-2,
+                  name=('WIDTH', 'HEIGHT')),
+        ]),
+    ])
+
+    def pointer(buttons, count, byte, names, labels):
+        # Mouse and single-touch reports, one byte then X and Y
+        return [
+            Field(INPUT, buttons, 1, count=count, lmax=1, name=names,
+                  byte=byte, label=labels),
+            Field(INPUT, [], 1, count=8 - count, lmax=1, flags=CNST),
+            Push([x, y]),
+        ]
+
+    def vendor(rid, usage, count, flags):
+        return [ReportId(rid),
+                Field(FEATURE, [U(VEN, 'Vendor Usage %d' % usage)], 8,
+                      count=Sym(count, 1), lmax=255, flags=flags)]
+
+    return [
+        Collection(APPLICATION, U(DIG, 'Touch Screen'), [
+            ReportId('MULTI_TOUCH_DATA_REPORT_ID', 'MULTI'),
+            Array(max_points, 'FINGER', [finger]),
+            Field(INPUT, [U(DIG, 'Contact Count')], 8, lmax=max_points,
+                  name='COUNT'),
+            ReportId('VALID_CONTACTS_FEATURE_REPORT_ID'),
+            Field(FEATURE, [U(DIG, 'Contact Count Maximum')], 8,
+                  lmax=max_points),
+        ], diagram='Data format'),
+        Collection(APPLICATION, U(DIG, 'Device Configuration'), [
+            ReportId('DEVICE_MODE_FEATURE_REPORT_ID'),
+            Collection(LOGICAL, U(DIG, 'Device Settings'), [
+                Field(FEATURE, [U(DIG, 'Device Mode'),
+                                U(DIG, 'Device Identifier')], 8, lmax=10),
+            ]),
+        ]),
+        Collection(APPLICATION, U(DIG, 'Touch Screen'), [
+            ReportId('SINGLE_TOUCH_DATA_REPORT_ID', 'SINGLE'),
+            Collection(PHYSICAL, U(DIG, 'Finger'), pointer(
+                [U(DIG, 'Tip Switch'), U(DIG, 'In Range')], 2, 'FLAGS',
+                ('TIP', 'RANGE'), ('Tip', 'Range'))),
+        ], diagram='Single-touch mode'),
+        Collection(APPLICATION, U(GD, 'Mouse'), [
+            ReportId('MOUSE_DATA_REPORT_ID', 'MOUSE'),
+            Collection(PHYSICAL, U(GD, 'Pointer'), pointer(
+                (BTN, 1, 2), 2, 'BUTTONS', ('LEFT', 'RIGHT'),
+                ('Left', 'Right'))),
+        ], diagram='Mouse mode'),
+        Collection(APPLICATION, U(MON, 'Monitor Control'), [
+            ReportId('BRIGHTNESS_FEATURE_REPORT_ID'),
+            Field(FEATURE, [U(VESA, 'Brightness')], 8, lmax=255),
+        ]),
+        Collection(APPLICATION, U(VEN, 'Vendor Usage 1'),
+                   vendor('CONFIG_FEATURE_REPORT_ID', 2,
+                          'sizeof(cfg_settings)', DATA)
+                   + vendor('BOOT_FEATURE_REPORT_ID', 3,
+                            'sizeof(boot_diag)', CNST)
+                   + vendor('STATS_FEATURE_REPORT_ID', 4,
+                            'sizeof(stats_counters)', CNST)
+                   + vendor('LATENCY_FEATURE_REPORT_ID', 5,
+                            'LAT_STAGES * LAT_BUCKETS', CNST)
+                   + vendor('SYNTH_FEATURE_REPORT_ID', 6,
+                            'sizeof(syn_control)', DATA)),
+    ]
+
+
+def read_defines(path):
+    defs = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'\s*#define\s+(\w+)\s+(?:\(uint8_t\))?\s*'
+                         r'(0x[0-9A-Fa-f]+|\d+)u?\b', line)
+            if m:
+                defs[m.group(1)] = int(m.group(2), 0)
+    return defs
+
+
+# Descriptor encoding
+
+class Encoder(object):
+    def __init__(self, ids):
+        self.ids = ids
+        self.items = []     # (code, comment, depth)
+        self.size = 0
+        # Nothing is in force until the descriptor sets it
+        self.g = dict(page=None, lmin=None, lmax=None, pmax=None, uexp=None,
+                      unit=None, size=None, count=None, id=None)
+        self.depth = 0
+
+    def item(self, tag, value, comment, signed=False, name=None):
+        if isinstance(value, Sym):
+            width = value.width
+            data = (['DESC_CONFIG_WORD(%s)' % value.name] if width == 2
+                    else [value.name])
+            comment = '%s (%s)' % (comment, value.name)
+        elif value is None:
+            width, data = 0, []
+        else:
+            width = 1
+            lo, hi = (-0x80, 0x7f) if signed else (0, 0xff)
+            while not lo <= value <= hi:
+                width *= 2
+                lo, hi = (lo << 8, (hi << 8) | 0xff) if width < 4 \
+                    else (-1 << 31, (1 << 31) - 1)
+            v = value & ((1 << 8 * width) - 1)
+            data = ['0x%02x' % (v >> 8 * k & 0xff) for k in range(width)]
+            comment = '%s (%s)' % (comment, name if name is not None
+                                   else value)
+        code = ', '.join(['0x%02x' % (tag | [0, 1, 2, None, 3][width])]
+                         + data)
+        self.items.append((code, comment, self.depth))
+        self.size += 1 + width
+
+    def glob(self, key, value, tag, label, signed=False, name=None):
+        if value is None:
+            return
+        cur = self.g[key]
+        if isinstance(value, Sym) or isinstance(cur, Sym):
+            if isinstance(value, Sym) and isinstance(cur, Sym) \
+                    and value.name == cur.name:
+                return
+        elif cur == value:
+            return
+        self.g[key] = value
+        self.item(tag, value, label, signed, name)
+
+    def usage(self, page, usage):
+        self.glob('page', page, 0x04, 'USAGE_PAGE', name=PAGES[page])
+        self.item(0x08, usage, 'USAGE', name=usage_name(page, usage))
+
+    def collection(self, c):
+        self.usage(*c.usage)
+        self.item(0xa0, c.kind, 'COLLECTION', name=COLLECTIONS[c.kind])
+        self.depth += 1
+        self.walk(c.items)
+        self.depth -= 1
+        self.item(0xc0, None, 'END_COLLECTION')
+
+    def field(self, f):
+        if isinstance(f.usages, tuple):
+            page, lo, hi = f.usages
+            self.glob('page', page, 0x04, 'USAGE_PAGE', name=PAGES[page])
+            self.item(0x18, lo, 'USAGE_MINIMUM', name=usage_name(page, lo))
+            self.item(0x28, hi, 'USAGE_MAXIMUM', name=usage_name(page, hi))
+        else:
+            for u in f.usages:
+                self.usage(*u)
+        self.glob('lmin', f.lmin, 0x14, 'LOGICAL_MINIMUM', True)
+        self.glob('lmax', f.lmax, 0x24, 'LOGICAL_MAXIMUM', True)
+        self.glob('pmax', f.pmax, 0x44, 'PHYSICAL_MAXIMUM', True)
+        if f.uexp is not None and f.uexp != self.g['uexp']:
+            self.g['uexp'] = f.uexp
+            self.item(0x54, f.uexp & 0x0f, 'UNIT_EXPONENT', name=f.uexp)
+        self.glob('unit', f.unit, 0x64, 'UNIT', name=UNITS.get(f.unit))
+        self.glob('size', f.size, 0x74, 'REPORT_SIZE')
+        self.glob('count', f.count, 0x94, 'REPORT_COUNT')
+        name = '%s,Var,Abs' % ('Cnst' if f.flags & 1 else 'Data')
+        self.item(f.kind | 0x01, f.flags,
+                  'INPUT' if f.kind == INPUT else 'FEATURE', name=name)
+
+    def walk(self, items):
+        for it in items:
+            if isinstance(it, Collection):
+                self.collection(it)
+            elif isinstance(it, Array):
+                for _ in range(it.n):
+                    self.walk(it.items)
+            elif isinstance(it, Push):
+                saved = dict(self.g)
+                self.item(0xa4, None, 'PUSH')
+                self.walk(it.items)
+                self.item(0xb4, None, 'POP')
+                # The report ID is global too, but is never set inside
+                self.g = saved
+            elif isinstance(it, ReportId):
+                rid = self.ids[it.define]
+                self.g['id'] = rid
+                self.item(0x84, rid, 'REPORT_ID')
+            else:
+                self.field(it)
+
+
+# Report layout, as the table describes it
+
+class Layout(object):
+    def __init__(self, ids):
+        self.ids = ids
+        self.bits = {}      # (report id, kind) -> bits so far
+        self.fields = []    # (report id, kind, bit, size, usage, field)
+        self.defines = []   # (prefix, name, value, comment)
+        self.rows = {}      # report prefix -> diagram rows
+        self.prefixes = {}  # report id -> prefix
+        self.unsized = set()  # (report id, kind) with a sizeof() count
+        self.rid = None
+        self.array = None   # (name, first bit) in the first array element
+        self.repeat = False # In the other array elements
+
+    def walk(self, items):
+        for it in items:
+            if isinstance(it, (Collection, Push)):
+                self.walk(it.items)
+            elif isinstance(it, Array):
+                key = (self.rid, INPUT)
+                start = self.bits.get(key, 0)
+                self.array = (it.name, start)
+                self.walk(it.items)
+                self.array = None
+                stride = self.bits[key] - start
+                self.repeat = True
+                for _ in range(it.n - 1):
+                    self.walk(it.items)
+                self.repeat = False
+                prefix = self.prefixes.get(self.rid)
+                if prefix:
+                    self.rows[prefix].append('... %d times' % it.n)
+                    self.define(prefix, it.name, 1 + start // 8)
+                    self.define(prefix, it.name + '_STRIDE', stride // 8)
+            elif isinstance(it, ReportId):
+                self.rid = self.ids[it.define]
+                if it.prefix:
+                    self.prefixes[self.rid] = it.prefix
+                    self.rows[it.prefix] = []
+            else:
+                self.field(it)
+
+    def define(self, prefix, name, value):
+        self.defines.append((prefix, name, value))
+
+    def field(self, f):
+        key = (self.rid, f.kind)
+        bit = self.bits.get(key, 0)
+        if isinstance(f.usages, tuple):
+            page, lo, hi = f.usages
+            usages = [(page, u) for u in range(lo, hi + 1)]
+        else:
+            usages = f.usages
+        count = f.count
+        if isinstance(count, Sym):
+            if count.value is None:
+                self.unsized.add(key)
+            count = count.value or 0
+        for k in range(count):
+            u = usages[min(k, len(usages) - 1)] if usages else None
+            self.fields.append((self.rid, f.kind, bit + k * f.size, f.size,
+                                u, f))
+        self.bits[key] = bit + count * f.size
+        if f.kind != INPUT or self.rid not in self.prefixes or self.repeat:
+            return
+
+        self.diagram(f, usages, bit, count, self.rows[self.prefixes[self.rid]])
+        # Offsets are from the report ID byte, or from the start of the
+        # element inside an Array
+        if self.array:
+            prefix, base = self.array
+        else:
+            prefix, base = self.prefixes[self.rid], -8
+        if f.byte:
+            self.define(prefix, f.byte, (bit - base) // 8)
+        for k in range(count):
+            name = f.names[k]
+            if not name:
+                continue
+            b = bit + k * f.size - base
+            if f.size < 8:
+                if b // 8 != (b + f.size - 1) // 8:
+                    raise SystemExit('%s_%s straddles a byte' % (prefix, name))
+                if f.size == 1:
+                    self.define(prefix, name, '0x%02x' % (1 << b % 8))
+                else:
+                    self.define(prefix, name + '_SHIFT', b % 8)
+            elif b % 8:
+                raise SystemExit('%s_%s is not byte aligned' % (prefix, name))
+            else:
+                self.define(prefix, name, b // 8)
+
+    def diagram(self, f, usages, bit, count, rows):
+        # One cell per field, split into rows of eight bits from bit 7 down
+        for k in range(count):
+            if f.flags & 1:
+                label = 'Padding'
+                size = f.size * count
+            else:
+                label = f.labels[k] or usage_name(*usages[k])
+                size = f.size
+            b = bit + k * f.size
+            first = True
+            while size:
+                n = min(size, 8 - b % 8)
+                if b % 8 == 0:
+                    rows.append([])
+                text = label
+                if f.size > 8:
+                    text = label + ' L' if first else ' ' * len(label) + ' H'
+                rows[-1].append((n, text))
+                first = False
+                b += n
+                size -= n
+            if f.flags & 1:
+                break
+
+    def lengths(self):
+        for rid, prefix in sorted(self.prefixes.items()):
+            bits = self.bits.get((rid, INPUT), 0)
+            if bits % 8:
+                raise SystemExit('input report %d is %d bits' % (rid, bits))
+            yield rid, prefix, 1 + bits // 8
+
+
+def render_rows(title, rows):
+    out = ['/* %s:' % title,
+           ' * ' + '|'.join([''] + ['  %d  ' % b for b in range(7, -1, -1)]
+                            + [''])]
+    for row in rows:
+        if isinstance(row, str):
+            out.append(' * ' + row)
+            continue
+        cells = []
+        for n, text in reversed(row):
+            width = 6 * n - 1
+            text = text if len(text) >= width - 1 else ' ' + text
+            cells.append(text[:width].ljust(width))
+        out.append(' * |' + '|'.join(cells) + '|')
+    out.append(' */')
+    return out
+
+
+def descriptor_lines(tbl, ids, layout):
+    enc = Encoder(ids)
+    diagrams = {}
+    for c in tbl:
+        start = len(enc.items)
+        enc.walk([c])
+        if c.diagram:
+            prefix = next(it.prefix for it in c.items
+                          if isinstance(it, ReportId) and it.prefix)
+            diagrams[start] = render_rows(c.diagram, layout.rows[prefix])
+    lines = []
+    for k, (code, comment, depth) in enumerate(enc.items):
+        lines += diagrams.get(k, [])
+        if k != len(enc.items) - 1:
+            code += ','
+        width = 31 if len(code) < 31 else 41 if len(code) < 41 \
+            else len(code) + 1
+        lines.append('    %s// %s%s' % (
+            code.ljust(width),
+            '  ' * depth, comment))
+    return lines, enc.size
+
+
+def header_text(size, layout):
+    out = ['/*',
+           ' * File:   hid_layout.h',
+           ' *',
+           ' * Created on October 19, 2026',
+           ' */',
+           '',
+           '// Generated by tools/hid_layout.py together with the report '
+           'descriptor in',
+           '// usb_descriptors.c, edit the table there and run it again.',
+           '',
+           '#ifndef HID_LAYOUT_H',
+           '#define\tHID_LAYOUT_H',
+           '',
+           '#ifdef\t__cplusplus',
+           'extern "C" {',
+           '#endif',
+           '',
+           '#define HID_RPT01_SIZE          %du' % size,
+           '']
+    arrays = [n for p, n, _ in layout.defines
+              if any(q == n for q, _, _ in layout.defines)]
+    for rid, prefix, length in layout.lengths():
+        out.append('// Input report %d, offsets from the report ID byte' % rid)
+        out.append(define('TP_RPT_%s_LEN' % prefix, length))
+        out += [define('TP_RPT_%s_%s' % (p, n), v)
+                for p, n, v in layout.defines if p == prefix]
+        for a in [n for p, n, _ in layout.defines
+                  if p == prefix and n in arrays]:
+            out.append('// Within each %s' % a.lower())
+            out += [define('TP_RPT_%s_%s' % (p, n), v)
+                    for p, n, v in layout.defines if p == a]
+        out.append('')
+    out += ['#ifdef\t__cplusplus',
+            '}',
+            '#endif',
+            '',
+            '#endif\t/* HID_LAYOUT_H */',
+            '']
+    return '\n'.join(out)
+
+
+def define(name, value):
+    return '#define %-23s %s' % (name, value)
+
+
+# Parsing the descriptor back out of usb_descriptors.c
+
+def extract(text, symbols):
+    i = text.index('hid_rpt01={')
+    j = text.index('};', i)
+    body = re.sub(r'/\*.*?\*/', '', text[i:j], flags=re.S)
+    body = re.sub(r'//[^\n]*', '', body)
+    body = body[body.index('{', body.index('{') + 1) + 1:].replace('}', '')
+    out = []
+    for tok in [t.strip() for t in body.split(',')]:
+        if not tok:
+            continue
+        m = re.match(r'DESC_CONFIG_WORD\((.*)\)$', tok)
+        if m:
+            v = symbols.get(m.group(1).strip(), 0x0101)
+            out += [v & 0xff, v >> 8 & 0xff]
+        elif re.match(r'0x[0-9a-fA-F]+$|\d+$', tok):
+            out.append(int(tok, 0))
+        else:
+            out.append(symbols.get(tok, 1))
+    return out
+
+
+def parse(d):
+    """Fields as (report id, kind, bit, size, usage, lmin, lmax, pmax, uexp,
+    unit)"""
+    g = dict(page=0, lmin=0, lmax=0, pmax=0, uexp=0, unit=0, size=0, count=0,
+             id=0)
+    stack = []
+    usages = []
+    umin = None
+    bits = {}
+    fields = []
+    depth = 0
+    i = 0
+    while i < len(d):
+        b = d[i]
+        n = [0, 1, 2, 4][b & 3]
+        data = d[i + 1:i + 1 + n]
+        if len(data) != n:
+            raise ValueError('item %02x at %d runs off the end' % (b, i))
+        i += 1 + n
+        v = 0
+        for k, x in enumerate(data):
+            v |= x << 8 * k
+        sv = v - (1 << 8 * n) if n and v >> (8 * n - 1) else v
+        t = b & 0xfc
+        if t == 0x04:
+            g['page'] = v
+        elif t == 0x14:
+            g['lmin'] = sv
+        elif t == 0x24:
+            g['lmax'] = sv
+        elif t == 0x34:
+            pass
+        elif t == 0x44:
+            g['pmax'] = sv
+        elif t == 0x54:
+            g['uexp'] = ((v & 0x0f) ^ 8) - 8
+        elif t == 0x64:
+            g['unit'] = v
+        elif t == 0x74:
+            g['size'] = v
+        elif t == 0x84:
+            g['id'] = v
+        elif t == 0x94:
+            g['count'] = v
+        elif b == 0xa4:
+            stack.append(dict(g))
+        elif b == 0xb4:
+            g = stack.pop()
+        elif t == 0x08:
+            usages.append((g['page'], v) if n < 4 else (v >> 16, v & 0xffff))
+        elif t == 0x18:
+            umin = v
+        elif t == 0x28:
+            usages += [(g['page'], u) for u in range(umin, v + 1)]
+        elif t == 0xa0:
+            depth += 1
+            usages = []
+        elif t == 0xc0:
+            depth -= 1
+        elif t in (INPUT, 0x90, FEATURE):
+            key = (g['id'], t)
+            o = bits.get(key, 0)
+            for c in range(g['count']):
+                u = usages[min(c, len(usages) - 1)] if usages else None
+                fields.append((g['id'], t, o, g['size'], u, g['lmin'],
+                               g['lmax'], g['pmax'], g['uexp'], g['unit']))
+                o += g['size']
+            bits[key] = o
+            usages = []
+        else:
+            raise ValueError('unexpected item %02x at %d' % (b, i - 1 - n))
+    if depth:
+        raise ValueError('%d collections left open' % depth)
+    return fields, bits
+
+
+def check_parse(text, layout, size, config):
+    errors = []
+    symbols = {'TF_X_MAX': 800, 'TF_Y_MAX': 480, 'TF_X_PHYS_MAX': 429,
+               'TF_Y_PHYS_MAX': 259, 'TP_SIZE_PHYS_MAX': 136}
+    d = extract(text, symbols)
+    if len(d) != size:
+        errors.append('descriptor is %d bytes, the table gives %d'
+                      % (len(d), size))
+    if config.get('HID_RPT01_SIZE') not in (None, len(d)):
+        errors.append('HID_RPT01_SIZE is %d, the descriptor is %d bytes'
+                      % (config['HID_RPT01_SIZE'], len(d)))
+    try:
+        parsed, bits = parse(d)
+    except ValueError as e:
+        return errors + ['descriptor does not parse: %s' % e]
+
+    def value(v):
+        return symbols.get(v.name) if isinstance(v, Sym) else v
+
+    # Units and physical extents left as None in the table are inherited
+    # and match anything
+    want = []
+    for rid, kind, bit, fsize, usage, f in layout.fields:
+        want.append((rid, kind, bit, fsize, usage, f.lmin, value(f.lmax),
+                     value(f.pmax), f.uexp, f.unit))
+    # Vendor reports sized by sizeof() only parse to a placeholder length
+    got = [p for p in parsed if (p[0], p[1]) not in layout.unsized]
+    want = [w for w in want if (w[0], w[1]) not in layout.unsized]
+    for k, (a, b) in enumerate(zip(want, got)):
+        if any(x is not None and x != y for x, y in zip(a, b)):
+            errors.append('field %d: table %s, descriptor %s'
+                          % (k, fmt_field(a), fmt_field(b)))
+            break
+    if len(want) != len(got):
+        errors.append('table has %d fields, descriptor %d'
+                      % (len(want), len(got)))
+
+    ep = config.get('HID_INT_IN_EP_SIZE')
+    for rid, prefix, n in layout.lengths():
+        if bits.get((rid, INPUT), 0) != 8 * (n - 1):
+            errors.append('input report %d parses to %d bits, not %d'
+                          % (rid, bits.get((rid, INPUT), 0), 8 * (n - 1)))
+        if ep is not None and n > ep:
+            errors.append('input report %d is %d bytes, HID_INT_IN_EP_SIZE '
+                          'is %d' % (rid, n, ep))
+    return errors
+
+
+def fmt_field(f):
+    rid, kind, bit, size, usage, lmin, lmax, pmax, uexp, unit = f
+    return ('id %d %s bit %d size %d usage %s logical %s..%s physical max %s '
+            'unit %s exponent %s' % (
+                rid, {INPUT: 'in', FEATURE: 'feature'}.get(kind, kind), bit,
+                size, usage and '%02x:%02x' % usage, lmin, lmax, pmax, unit,
+                uexp))
+
+
+def splice(text, lines, nl):
+    start = text.index('hid_rpt01={')
+    start = text.index('{', start + len('hid_rpt01={')) + 1
+    start = text.index(nl, start) + len(nl)
+    end = text.index('    }' + nl + '};// end of HID report descriptor',
+                     start)
+    return text[:start] + nl.join(lines) + nl + text[end:]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('--check', action='store_true',
+                    help='verify instead of writing')
+    args = ap.parse_args()
+
+    config = read_defines(USB_CONFIG)
+    max_points = read_defines(TOUCHPANEL)['TP_MAX_POINTS']
+    tbl = table(max_points)
+
+    layout = Layout(config)
+    layout.walk(tbl)
+    lines, size = descriptor_lines(tbl, config, layout)
+    header = header_text(size, layout)
+
+    with open(DESCRIPTORS, 'rb') as f:
+        raw = f.read().decode('latin-1')
+    nl = '\r\n' if '\r\n' in raw else '\n'
+    descriptors = splice(raw, lines, nl)
+    try:
+        with open(HEADER) as f:
+            old_header = f.read()
+    except IOError:
+        old_header = ''
+
+    if not args.check:
+        if descriptors != raw:
+            with open(DESCRIPTORS, 'wb') as f:
+                f.write(descriptors.encode('latin-1'))
+        if header != old_header:
+            with open(HEADER, 'w') as f:
+                f.write(header)
+        print('descriptor %d bytes' % size)
+        for rid, prefix, n in layout.lengths():
+            print('input report %d (%s) %d bytes' % (rid, prefix, n))
+        return
+
+    errors = []
+    for path, old, new in ((DESCRIPTORS, raw, descriptors),
+                           (HEADER, old_header, header)):
+        if old != new:
+            errors.append('%s is out of date:' % os.path.relpath(path))
+            errors += [l.rstrip('\r\n') for l in difflib.unified_diff(
+                old.splitlines(True), new.splitlines(True), 'current',
+                'generated', n=1)]
+    config['HID_RPT01_SIZE'] = read_defines(HEADER).get('HID_RPT01_SIZE') \
+        if old_header else None
+    errors += check_parse(raw, layout, size, config)
+    for e in errors:
+        print(e)
+    if errors:
+        sys.exit(1)
+    print('ok, descriptor %d bytes' % size)
+
+
+if __name__ == '__main__':
+    main()
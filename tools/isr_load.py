@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""Measure the time spent in the high priority (USB) interrupt, on Linux.
+
+Reads the counters feature report twice, some seconds apart, and divides
+the growth of isr_hi_total by the SOF packets seen meanwhile. That gives
+the interrupt's cost per millisecond frame, which comes straight out of
+the time left for reading the touch panel. Run it against builds with and
+without USB_ENABLE_ISR_FAST_PATH (usb_config.h) to compare them, with the
+panel idle and then while touching it.
+
+    sudo isr_load.py -t 10
+"""
+
+import argparse
+import fcntl
+import glob
+import os
+import struct
+import sys
+import time
+
+STATS_REPORT_ID = 7
+# stats_counters up to isr_hi_total, see stats.h (XC8 is little endian and
+# does not pad)
+STATS = struct.Struct('<3L9HL')
+FIELDS = ('frames', 'reports', 'sofs', 'dropped', 'coalesced',
+          'i2c_timeouts', 'i2c_naks', 'bus_errors', 'isr_hi_max',
+          'isr_hi_mean', 'isr_lo_max', 'isr_lo_mean', 'isr_hi_total')
+COUNTS_PER_MS = 3000  # TICK_FAST_PER_US
+CYCLES_PER_COUNT = 4  # Timer1 prescaler
+
+
+def HIDIOCGFEATURE(length):
+    # _IOC(_IOC_WRITE | _IOC_READ, 'H', 0x07, length)
+    return (3 << 30) | (length << 16) | (ord('H') << 8) | 0x07
+
+
+def find_hidraw(vid, pid):
+    for path in glob.glob('/sys/class/hidraw/hidraw*'):
+        try:
+            with open(os.path.join(path, 'device', 'uevent')) as f:
+                uevent = f.read()
+        except OSError:
+            continue
+        want = 'HID_ID=0003:%08X:%08X' % (vid, pid)
+        if want in uevent.upper():
+            return '/dev/' + os.path.basename(path)
+    return None
+
+
+def read_stats(fd):
+    buf = bytearray(64)
+    buf[0] = STATS_REPORT_ID
+    n = fcntl.ioctl(fd, HIDIOCGFEATURE(len(buf)), buf, True)
+    if n < 1 + STATS.size:
+        sys.exit('stats report is %d bytes, firmware too old?' % n)
+    return dict(zip(FIELDS, STATS.unpack_from(buf, 1)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('-t', type=float, default=5, help='seconds (default 5)')
+    ap.add_argument('--vid', type=lambda s: int(s, 16), default=0x04D8)
+    ap.add_argument('--pid', type=lambda s: int(s, 16), default=0x0063)
+    args = ap.parse_args()
+
+    dev = find_hidraw(args.vid, args.pid)
+    if not dev:
+        sys.exit('device %04x:%04x not found' % (args.vid, args.pid))
+    fd = os.open(dev, os.O_RDWR)
+    a = read_stats(fd)
+    time.sleep(args.t)
+    b = read_stats(fd)
+    os.close(fd)
+
+    d = {k: (b[k] - a[k]) % (1 << 32) for k in ('sofs', 'frames', 'reports',
+                                                 'isr_hi_total')}
+    if not d['sofs']:
+        sys.exit('no SOF packets counted, is the device configured?')
+    per_sof = d['isr_hi_total'] / d['sofs']
+    print('%d SOFs, %d frames, %d reports' % (d['sofs'], d['frames'],
+                                              d['reports']))
+    print('high priority interrupt: %.0f cycles (%.1f us) per ms, %.2f%% '
+          'of the CPU' % (per_sof * CYCLES_PER_COUNT, per_sof / 3,
+                          100.0 * per_sof / COUNTS_PER_MS))
+    print('longest %d cycles, recent mean %d cycles' % (
+        b['isr_hi_max'] * CYCLES_PER_COUNT,
+        b['isr_hi_mean'] * CYCLES_PER_COUNT))
+
+
+if __name__ == '__main__':
+    main()
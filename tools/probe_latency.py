@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""Per-frame touch to USB latency from a logic analyzer capture.
+
+Build the firmware with PROBE_ENABLE defined in probe.h, connect RC4 (probe
+A) and RC6 (probe B) to two analyzer channels and export the capture from
+sigrok-cli or PulseView as CSV, e.g.
+
+    sigrok-cli -d fx2lafw -c samplerate=4m -C D0,D1 --time 10s \\
+        -O csv -o capture.csv
+
+Probe A is high from INT1 seen to frame decoded, probe B from report armed
+to report collected by the host. Times are printed in microseconds.
+"""
+
+import argparse
+import csv
+import re
+import sys
+
+UNITS = {'': 1, 'k': 1e3, 'm': 1e6, 'g': 1e9}
+
+
+def parse_rate(text):
+    m = re.match(r'\s*([0-9.]+)\s*([kKmMgG]?)\s*Hz', text)
+    if not m:
+        raise ValueError('bad samplerate: %r' % text)
+    return float(m.group(1)) * UNITS[m.group(2).lower()]
+
+
+def read_capture(path, chan_a, chan_b, rate):
+    """Return [(time_s, a, b)] for every change of either probe.
+
+    Times come from a time column if the capture has one, otherwise from
+    the sample index and rate, which is read from the capture header unless
+    given.
+    """
+    edges = []
+    header = None
+    time_col = None
+    last = None
+    n = 0
+
+    with open(path, newline='') as f:
+        for row in csv.reader(f):
+            if not row:
+                continue
+            if row[0].startswith(';'):
+                m = re.search(r'Samplerate:\s*(.*)', ','.join(row))
+                if m and rate is None:
+                    rate = parse_rate(m.group(1))
+                continue
+            cells = [c.strip() for c in row]
+            if header is None:
+                header = cells
+                for name in (chan_a, chan_b):
+                    if name not in header:
+                        sys.exit('channel %s not in %s' % (name, header))
+                if header[0].lower() == 'time':
+                    time_col = 0
+                ia = header.index(chan_a)
+                ib = header.index(chan_b)
+                continue
+            try:
+                a = int(cells[ia])
+                b = int(cells[ib])
+                t = float(cells[time_col]) if time_col is not None else None
+            except ValueError:
+                # Channel type row written by some libsigrok versions
+                continue
+            if t is None:
+                if rate is None:
+                    sys.exit('no samplerate in capture, pass --samplerate')
+                t = n / rate
+            n += 1
+            if (a, b) != last:
+                edges.append((t, a, b))
+                last = (a, b)
+
+    return edges
+
+
+def frames(edges):
+    """Split the edge list into frames, one per probe A pulse."""
+    out = []
+    cur = None
+    prev_a = prev_b = None
+
+    for t, a, b in edges:
+        if prev_a is not None:
+            if a and not prev_a:
+                if cur:
+                    out.append(cur)
+                cur = {'int': t}
+            elif not a and prev_a and cur:
+                cur['decoded'] = t
+            if b and not prev_b and cur and 'decoded' in cur:
+                cur['armed'] = t
+            elif not b and prev_b and cur and 'armed' in cur:
+                cur['done'] = t
+        prev_a, prev_b = a, b
+
+    if cur:
+        out.append(cur)
+    return out
+
+
+def percentile(values, p):
+    k = (len(values) - 1) * p / 100.0
+    lo = int(k)
+    hi = min(lo + 1, len(values) - 1)
+    return values[lo] + (values[hi] - values[lo]) * (k - lo)
+
+
+def summary(name, values):
+    if not values:
+        print('%-18s %6d' % (name, 0))
+        return
+    v = sorted(x * 1e6 for x in values)
+    print('%-18s %6d %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f' % (
+        name, len(v), v[0], sum(v) / len(v), percentile(v, 50),
+        percentile(v, 95), percentile(v, 99), v[-1]))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('capture', help='sigrok CSV export')
+    ap.add_argument('-a', default='D0', help='probe A channel (default D0)')
+    ap.add_argument('-b', default='D1', help='probe B channel (default D1)')
+    ap.add_argument('--samplerate', type=parse_rate,
+                    help='e.g. "4 MHz", if not in the capture header')
+    ap.add_argument('--frames', metavar='CSV',
+                    help='also write per-frame times to this file')
+    args = ap.parse_args()
+
+    edges = read_capture(args.capture, args.a, args.b, args.samplerate)
+    fr = frames(edges)
+    # The last frame may have been cut off by the end of the capture
+    if fr and 'done' not in fr[-1]:
+        fr.pop()
+
+    stages = [
+        ('int->decoded', 'int', 'decoded'),
+        ('decoded->armed', 'decoded', 'armed'),
+        ('armed->done', 'armed', 'done'),
+        ('int->armed', 'int', 'armed'),
+        ('int->done', 'int', 'done'),
+    ]
+    sent = [f for f in fr if 'done' in f]
+    print('%d frames, %d sent, %d not sent' % (
+        len(fr), len(sent), len(fr) - len(sent)))
+    print('%-18s %6s %9s %9s %9s %9s %9s %9s' % (
+        'stage (us)', 'n', 'min', 'mean', 'p50', 'p95', 'p99', 'max'))
+    for name, start, end in stages:
+        summary(name, [f[end] - f[start] for f in fr
+                       if start in f and end in f])
+    summary('frame interval', [b['int'] - a['int']
+                               for a, b in zip(fr, fr[1:])])
+
+    if args.frames:
+        with open(args.frames, 'w', newline='') as f:
+            w = csv.writer(f)
+            w.writerow(['int_s'] + [s[0] for s in stages])
+            for fm in fr:
+                w.writerow(['%.9f' % fm['int']] + [
+                    '%.1f' % ((fm[e] - fm[s]) * 1e6)
+                    if s in fm and e in fm else ''
+                    for _, s, e in stages])
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Decode the trace log sent on the EUSART TX pin.
+
+Build the firmware with TRACE_ENABLE defined in trace.h and connect RB7 to
+a 3.3V serial adapter. Read from the port directly (needs pyserial)
+
+    trace_decode.py /dev/ttyUSB0
+
+or from a raw capture file with --file. Record names are taken from the
+TRACE_* defines in trace.h so the two stay in step.
+
+Timestamps are Timer1 counts, which wrap every 21.8ms. They are unwrapped
+assuming no gap between records is longer than that, so the absolute time
+after a long quiet period is only approximate; the time within a burst is
+exact.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SYNC = 0xA5
+RECORD = 5
+COUNTS_PER_US = 3  # TICK_FAST_PER_US
+BAUD = 1000000
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+HEADER = os.path.join(HERE, '..', 'trace.h')
+
+
+def load_names(path):
+    names = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r'#define\s+TRACE_(\w+)\s+0x([0-9A-Fa-f]+)\b', line)
+            if m and m.group(1) != 'SYNC':
+                names[int(m.group(2), 16)] = m.group(1)
+    return names
+
+
+def records(read):
+    """Yield (id, arg, time) from a byte source, resyncing on the marker."""
+    buf = bytearray()
+    while True:
+        chunk = read()
+        if not chunk:
+            break
+        buf += chunk
+        while len(buf) >= RECORD:
+            if buf[0] != SYNC:
+                del buf[0]
+                continue
+            rec = buf[:RECORD]
+            yield rec[1], rec[2], rec[3] | rec[4] << 8
+            del buf[:RECORD]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    ap.add_argument('port', nargs='?', help='serial port')
+    ap.add_argument('--file', help='decode a raw capture instead')
+    ap.add_argument('--baud', type=int, default=BAUD)
+    ap.add_argument('--header', default=HEADER, help='path to trace.h')
+    args = ap.parse_args()
+
+    names = load_names(args.header)
+
+    if args.file:
+        f = open(args.file, 'rb')
+        read = lambda: f.read(256)
+    elif args.port:
+        import serial
+        port = serial.Serial(args.port, args.baud)
+        # Block for at least one byte, then take whatever has arrived
+        read = lambda: port.read(max(1, port.in_waiting))
+    else:
+        ap.error('give a serial port or --file')
+
+    base = 0
+    last = None
+    try:
+        for rid, arg, t in records(read):
+            if rid not in names:
+                print('?? %02x %02x %04x' % (rid, arg, t))
+                continue
+            if last is not None and t < last:
+                base += 0x10000
+            now = (base + t) / COUNTS_PER_US
+            delta = (t - last) % 0x10000 / COUNTS_PER_US \
+                if last is not None else 0
+            last = t
+            name = names[rid]
+            if name == 'BOOT':
+                # The firmware restarted, start the clock over
+                base = 0
+                now = t / COUNTS_PER_US
+            print('%12.1f %+10.1f  %-12s %3d' % (now, delta, name, arg))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
@@ -1,24 +1,268 @@
 #include <xc.h>
+#include <string.h>
 #include "i2c.h"
 #include "touchpanel.h"
+#include "transform.h"
+#include "filter.h"
+#include "contact_id.h"
+#include "idle.h"
+#include "settings.h"
+#include "boot.h"
+#include "event.h"
+#include "power.h"
+#include "stats.h"
+#include "latency.h"
+#include "probe.h"
+#include "trace.h"
+#include "synth.h"
+#include "tick.h"
 #include "usb/usb.h"
 #include "usb/usb_device_hid.h"
+#include "app_device_hid_digitizer_multi.h"
 
 #define I2C_SLAVE 0x38
 
 static unsigned char hid_report_in[HID_INT_IN_EP_SIZE] DEVICE_HID_DIGITIZER_IN_BUFFER_ADDRESS;
 static touch_data tp_data;
+static touch_point tp_raw[TP_MAX_POINTS];
+static unsigned char tp_raw_count;
+static touch_point tp_contacts[TP_MAX_POINTS];
+static unsigned char tp_count;
+
+// Frames read while the bus is suspended, sent once the host resumes: the
+// first one with contacts, then the latest one with contacts so the host
+// also sees the lift. Frames without contacts are not kept, since the
+// frame reporting the lift is the last one that has any.
+static touch_point tp_wake_contacts[TP_MAX_POINTS];
+static unsigned char tp_wake_count;
+static touch_point tp_wake_last[TP_MAX_POINTS];
+static unsigned char tp_wake_last_count;
+static bool tp_stale;
+static bool tp_hibernating;
+
+// Contact followed in the mouse and single-touch modes
+#define TP_NO_PRIMARY 0xFF
+static unsigned char tp_primary_id = TP_NO_PRIMARY;
+
+// Fingers holding contact data in hid_report_in, one bit per slot. The
+// buffer is not cleared at startup, so all of them to begin with.
+#if TP_MAX_POINTS > 8
+#error "Finger slots are tracked in a byte"
+#endif
+#define TP_ALL_SLOTS ((1 << TP_MAX_POINTS) - 1)
+static unsigned char tp_multi_slots = TP_ALL_SLOTS;
+
+// Slots filled by each contact count
+static const unsigned char tp_slot_mask[] = {
+    0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF
+};
+
+// High nibble of a byte, a SWAPF and ANDLW with XC8
+#define TP_NIBBLE_HI(b) ((unsigned char) ((unsigned char) (b) >> 4))
+
+// Store a 16-bit value a byte at a time (XC8 is little endian), rather than
+// shifting and ORing the bytes together in a register pair
+#define TP_STORE16(dst, hi, lo) do { \
+                                    ((unsigned char *) &(dst))[0] = (lo); \
+                                    ((unsigned char *) &(dst))[1] = (hi); \
+                                } while (0)
+
+#ifdef TP_PACK_BENCH
+static touch_point tp_bench_pts[TP_MAX_POINTS];
+static unsigned char tp_bench_report[TP_RPT_MULTI_LEN];
+static unsigned int tp_bench_avg[TP_BENCH_MISMATCH]; // Moving averages, scaled by 16
+static unsigned int tp_bench_start;
+static unsigned char tp_bench_gie;
+static bool tp_bench_tx_ref; // Arm the next report through HIDTxPacket()
+
+/**
+ * Start timing, with interrupts held off so USB traffic does not land in
+ * the measurement
+ */
+static void tp_bench_begin(void) {
+    tp_bench_gie = INTCON & 0xC0; // GIEH, GIEL
+    INTCONbits.GIEH = 0;
+    tp_bench_start = tick_fast();
+}
+
+/**
+ * Finish timing and update the stats
+ *
+ * Both sides of each comparison include the same tick_fast() overhead.
+ * @param which TP_BENCH_*
+ */
+static void tp_bench_end(unsigned char which) {
+    unsigned int d = tick_fast() - tp_bench_start;
+
+    INTCON |= tp_bench_gie;
+    tp_bench_avg[which] += d - (tp_bench_avg[which] >> 4);
+    // Timer1 counts four instruction cycles
+    stats.bench[which] = tp_bench_avg[which] >> 2;
+}
+
+// The unpacking tp_decode() used before, through the touch_reg bitfields
+static void tp_unpack_ref(touch_point *pts, unsigned char count) {
+    unsigned char i;
+    touch_reg *reg;
+    touch_point *pt;
+
+    for (i = 0; i < count; i++) {
+        reg = &tp_data.data.TOUCH[i];
+        pt = &pts[i];
+        pt->x = ((unsigned int) reg->XH << 8) | reg->XL;
+        pt->y = ((unsigned int) reg->YH << 8) | reg->YL;
+        pt->id = reg->ID;
+        pt->event = reg->EVENT;
+        pt->area = reg->AREA;
+    }
+}
+
+// The packing tp_pack_multi() used before, every slot written every frame
+static void tp_pack_multi_ref(unsigned char *out, const touch_point *pts,
+        unsigned char count) {
+    unsigned char i;
+    unsigned char *report;
+    unsigned char flags;
+    const touch_point *pt;
+
+    out[0] = MULTI_TOUCH_DATA_REPORT_ID;
+
+    report = &out[TP_RPT_MULTI_FINGER];
+    for (i = 0; i < TP_MAX_POINTS; i++) {
+        if (i < count) {
+            pt = &pts[i];
+            flags = (pt->event != TP_EVENT_UP)
+                    ? TP_RPT_FINGER_TIP | TP_RPT_FINGER_RANGE : 0;
+            if (pt->area < TP_PALM_AREA) flags |= TP_RPT_FINGER_CONFIDENCE;
+            report[TP_RPT_FINGER_FLAGS] = flags | pt->id << TP_RPT_FINGER_ID_SHIFT;
+            report[TP_RPT_FINGER_X] = pt->x;
+            report[TP_RPT_FINGER_X + 1] = pt->x >> 8;
+            report[TP_RPT_FINGER_Y] = pt->y;
+            report[TP_RPT_FINGER_Y + 1] = pt->y >> 8;
+            report[TP_RPT_FINGER_WIDTH] = pt->area * TP_AREA_SCALE;
+            report[TP_RPT_FINGER_HEIGHT] = report[TP_RPT_FINGER_WIDTH];
+        } else {
+            memset(report, 0, TP_RPT_MULTI_FINGER_STRIDE);
+        }
+        report += TP_RPT_MULTI_FINGER_STRIDE;
+    }
+
+    out[TP_RPT_MULTI_COUNT] = count;
+}
+#endif
 
 extern USB_HANDLE lastTransmission;
 
-void tp_service(void) {
-    if (!INTCON3bits.INT1IF) return;
+/**
+ * Hand a controller interrupt to the main loop
+ *
+ * Called from the low-priority interrupt. INT1 stays disabled until
+ * tp_service() has read the frame.
+ */
+void tp_isr(void) {
+    if (!INTCON3bits.INT1IE || !INTCON3bits.INT1IF) return;
     INTCON3bits.INT1IE = 0;
+    lat_mark(LAT_T_INT);
+    PROBE_INT();
+    TRACE(TRACE_INT, 0);
+    evt_post(EVT_TOUCH);
+}
+
+/**
+ * Read, process and send one frame
+ *
+ * Called from the main loop for EVT_TOUCH.
+ */
+void tp_service(void) {
+    // Clear first so a frame signalled while this one is read is not lost
+    INTCON3bits.INT1IF = 0;
+
+    // A frame signalled just before hibernation is not worth waking for
+    if (tp_hibernating) return;
 
     tp_read();
-    tp_send();
+    stats.frames++;
+    stats_i2c(i2c_Errors());
+    tp_decode();
+    PROBE_DECODED();
+    TRACE(TRACE_FRAME, tp_raw_count);
+    // The idle policy may hold back the touch that woke the backlight
+    if (!idle_activity(tp_contacts, tp_count)) {
+        stats.dropped++;
+        TRACE(TRACE_DROPPED, tp_count);
+    } else if (tp_count) {
+        if (pwr_suspended()) {
+            if (!tp_wake_count) {
+                memcpy(tp_wake_contacts, tp_contacts, sizeof (tp_wake_contacts));
+                tp_wake_count = tp_count;
+            } else {
+                memcpy(tp_wake_last, tp_contacts, sizeof (tp_wake_last));
+                tp_wake_last_count = tp_count;
+                tp_stale = true;
+            }
+            pwr_remote_wakeup();
+        } else if (USBGetDeviceState() == CONFIGURED_STATE && !syn_active()) {
+            tp_send(tp_contacts, tp_count);
+            boot_mark(BOOT_STAGE_FIRST_TOUCH);
+        } else {
+            stats.dropped++;
+            TRACE(TRACE_DROPPED, tp_count);
+        }
+    }
+
+    // Another frame was signalled while this one was read
+    if (INTCON3bits.INT1IF) stats.coalesced++;
+    INTCON3bits.INT1IE = 1;
+}
+
+/**
+ * Put the controller into a low power mode
+ * @param monitor Keep scanning slowly so a touch can wake the host,
+ *  otherwise hibernate and hold it in reset
+ */
+void tp_suspend(bool monitor) {
+    tp_wake_count = 0;
+    tp_stale = false;
+
+    if (monitor) {
+        tp_write_reg(TP_REG_PMODE, TP_PMODE_MONITOR);
+        return;
+    }
+
+    INTCON3bits.INT1IE = 0;
+    tp_write_reg(TP_REG_PMODE, TP_PMODE_HIBERNATE);
+    LATCbits.LATC0 = 0;
+    tp_hibernating = true;
+}
+
+/**
+ * Return the controller to active scanning
+ *
+ * A touch that woke the host is sent now. After hibernation the controller
+ * restarts from reset and tracking starts over; its interrupt is enabled
+ * by boot_tasks() once it answers, as at power up.
+ */
+void tp_resume(void) {
+    if (tp_hibernating) {
+        tp_hibernating = false;
+        LATCbits.LATC0 = 1;
+        flt_reset();
+        cid_reset();
+        boot_restart();
+        return;
+    }
+
+    tp_write_reg(TP_REG_PMODE, TP_PMODE_ACTIVE);
+
+    if (tp_wake_count) {
+        // These frames were read long ago, only time them from packing
+        lat_drop();
+        tp_send(tp_wake_contacts, tp_wake_count);
+        if (tp_stale) tp_send(tp_wake_last, tp_wake_last_count);
+        tp_wake_count = 0;
+        tp_stale = false;
+    }
 
-    INTCON3bits.INT1IF = 0;
     INTCON3bits.INT1IE = 1;
 }
 
@@ -40,9 +284,22 @@ void tp_init(void) {
     TRISCbits.TRISC0 = 0;
 
     i2c_Init();
+    i2c_SetDivider(cfg.i2c_sspadd);
+    tf_init();
+    flt_reset();
+    cid_reset();
+}
+
+/**
+ * Release the controller from reset without enabling its interrupt
+ */
+void tp_wake(void) {
+    LATCbits.LATC0 = 1;
 }
 
 void tp_enable(void) {
+    // Hibernated again while boot_tasks() waited for it to answer
+    if (tp_hibernating) return;
     LATCbits.LATC0 = 1;
     INTCON3bits.INT1IE = 1;
 }
@@ -60,22 +317,56 @@ unsigned char tp_points(void) {
     unsigned char num_points;
 
     // Read number of points
+    num_points = tp_read_reg(0x02);
+
+    num_points = num_points & 0b00000111;
+
+    return num_points;
+}
+
+/**
+ * Read a single controller register
+ *
+ * A controller that is absent or still starting up does not acknowledge,
+ * and the read returns 0xFF from the bus pull-ups.
+ * @param reg
+ * @return
+ */
+unsigned char tp_read_reg(unsigned char reg) {
+    unsigned char value;
+
     i2c_Start();
     i2c_Address(I2C_SLAVE, I2C_WRITE);
-    i2c_Write(0x02);
+    i2c_Write(reg);
     i2c_Restart();
     i2c_Address(I2C_SLAVE, I2C_READ);
-    num_points = i2c_Read(0);
+    value = i2c_Read(0);
     i2c_Stop();
+    // Callers judge the value, a missing controller is not an error here
+    i2c_Errors();
 
-    num_points = num_points & 0b00000111;
+    return value;
+}
 
-    return num_points;
+/**
+ * Write a single controller register
+ * @param reg
+ * @param value
+ */
+void tp_write_reg(unsigned char reg, unsigned char value) {
+    i2c_Start();
+    i2c_Address(I2C_SLAVE, I2C_WRITE);
+    i2c_Write(reg);
+    i2c_Write(value);
+    i2c_Stop();
+    stats_i2c(i2c_Errors());
 }
 
 void tp_read(void) {
     unsigned char i;
 
+    lat_mark(LAT_T_I2C_START);
+
     // Read one byte
     i2c_Start(); // send Start
     i2c_Address(I2C_SLAVE, I2C_WRITE); // Send slave address with write operation
@@ -83,68 +374,252 @@ void tp_read(void) {
     i2c_Restart(); // Restart
     i2c_Address(I2C_SLAVE, I2C_READ); // Send slave address with read operation
 
-    for (i = 0; i < 0x1E; i++) {
+    for (i = 0; i < TP_REG_COUNT - 1; i++) {
         tp_data.raw[i] = i2c_Read(1);
     }
-    tp_data.raw[0x1E] = i2c_Read(0);
+    tp_data.raw[TP_REG_COUNT - 1] = i2c_Read(0);
 
     i2c_Stop(); // send Stop
+    lat_mark(LAT_T_I2C_END);
 }
 
 /**
- * Populate USB buffer with touch pad multitouch data
+ * Unpack touch registers into contacts
  *
- * This should only be called by whatever method is handling USB delegation
+ * Works a byte at a time: the nibbles come out with a swap and mask and
+ * the coordinates are stored a byte at a time, where the touch_reg
+ * bitfields cost a mask and shift sequence per field.
+ * @param pts
+ * @param count
  */
-void tp_send(void) {
-    while (USBHandleBusy(lastTransmission)) {}
+static void tp_unpack(touch_point *pts, unsigned char count) {
+    const unsigned char *r = (const unsigned char *) tp_data.data.TOUCH;
+    unsigned char b;
+
+    for (; count; count--) {
+        b = r[TP_TOUCH_XH];
+        pts->event = b >> 6;
+        TP_STORE16(pts->x, b & 0x0F, r[TP_TOUCH_XL]);
+        b = r[TP_TOUCH_YH];
+        pts->id = TP_NIBBLE_HI(b);
+        TP_STORE16(pts->y, b & 0x0F, r[TP_TOUCH_YL]);
+        pts->area = TP_NIBBLE_HI(r[TP_TOUCH_AREA]);
+        r += sizeof (touch_reg);
+        pts++;
+    }
+}
+
+/**
+ * Unpack the register snapshot into contacts, map them to report
+ * coordinates, filter out glitches and assign host contact IDs
+ */
+void tp_decode(void) {
+    unsigned char i;
+
+    // A controller that did not answer reads back as 0xFF
+    tp_raw_count = tp_data.data.TD_STATUS;
+    if (tp_raw_count > TP_MAX_POINTS) tp_raw_count = 0;
+
+#ifdef TP_PACK_BENCH
+    tp_bench_begin();
+    tp_unpack_ref(tp_bench_pts, tp_raw_count);
+    tp_bench_end(TP_BENCH_UNPACK_REF);
+    tp_bench_begin();
+#endif
+    tp_unpack(tp_raw, tp_raw_count);
+#ifdef TP_PACK_BENCH
+    tp_bench_end(TP_BENCH_UNPACK);
+    if (memcmp(tp_bench_pts, tp_raw, tp_raw_count * sizeof (touch_point))) {
+        stats.bench[TP_BENCH_MISMATCH]++;
+    }
+#endif
+
+    for (i = 0; i < tp_raw_count; i++) {
+        tf_apply(&tp_raw[i]);
+    }
+
+    tp_count = flt_apply(tp_raw, tp_raw_count, tp_contacts);
+    cid_assign(tp_contacts, tp_count);
+}
+
+/**
+ * Pick the contact that drives the mouse and single-touch reports
+ *
+ * The first contact to touch down is followed until it lifts; contacts that
+ * touch down meanwhile are not reported.
+ * @return The contact, or 0 if none should be reported
+ */
+static const touch_point *tp_primary(const touch_point *pts, unsigned char count) {
+    unsigned char i;
+
+    for (i = 0; i < count; i++) {
+        if (pts[i].id == tp_primary_id) {
+            if (pts[i].event == TP_EVENT_UP) tp_primary_id = TP_NO_PRIMARY;
+            return &pts[i];
+        }
+    }
+    for (i = 0; i < count; i++) {
+        if (pts[i].event == TP_EVENT_DOWN) {
+            tp_primary_id = pts[i].id;
+            return &pts[i];
+        }
+    }
+    return 0;
+}
+
+// tp_pack_multi() stores each finger's fields in a single pass
+#if TP_RPT_FINGER_FLAGS != 0 || TP_RPT_FINGER_X != 1 || TP_RPT_FINGER_Y != 3 \
+        || TP_RPT_FINGER_WIDTH != 5 || TP_RPT_FINGER_HEIGHT != 6 \
+        || TP_RPT_MULTI_FINGER_STRIDE != 7
+#error "The finger layout in hid_layout.h no longer matches tp_pack_multi()"
+#endif
+
+// Multi-touch: one finger per touch point, then the contact count. Slots
+// past the contact count are zero, and the host ignores them anyway. Offsets
+// are generated with the report descriptor, see hid_layout.h.
+static unsigned char tp_pack_multi(const touch_point *pts, unsigned char count) {
+    unsigned char *report = &hid_report_in[TP_RPT_MULTI_FINGER];
+    unsigned char active = tp_slot_mask[count];
+    // Slots still holding contacts from an earlier report
+    unsigned char stale = tp_multi_slots & (unsigned char) ~active;
+    unsigned char flags;
+    unsigned char size;
 
     // Report ID for multi-touch contact information reports (based on report descriptor)
-    hid_report_in[0] = 0x01; //Report ID in byte[0]
-
-
-    // Touch point 1
-    hid_report_in[1] = ((tp_data.data.TOUCH_POINTS >= 1) ? 3 : 0)
-            | tp_data.data.TOUCH1_ID << 2;
-    //First contact info in bytes 1-6
-    hid_report_in[2] = tp_data.data.TOUCH1_XL; //X-coord LSB
-    hid_report_in[3] = tp_data.data.TOUCH1_XH; //X-coord MSB
-    hid_report_in[4] = tp_data.data.TOUCH1_YL; //Y-coord LSB
-    hid_report_in[5] = tp_data.data.TOUCH1_YH; //Y-coord MSB
-
-    // Touch point 2
-    hid_report_in[6] = ((tp_data.data.TOUCH_POINTS >= 2) ? 3 : 0)
-            | tp_data.data.TOUCH2_ID << 2;
-    hid_report_in[7] = tp_data.data.TOUCH2_XL; //X-coord LSB
-    hid_report_in[8] = tp_data.data.TOUCH2_XH; //X-coord MSB
-    hid_report_in[9] = tp_data.data.TOUCH2_YL; //Y-coord LSB
-    hid_report_in[10] = tp_data.data.TOUCH2_YH; //Y-coord MSB
-
-    // Touch point 3
-    hid_report_in[11] = ((tp_data.data.TOUCH_POINTS >= 3) ? 3 : 0)
-            | tp_data.data.TOUCH3_ID << 2;
-    hid_report_in[12] = tp_data.data.TOUCH3_XL; //X-coord LSB
-    hid_report_in[13] = tp_data.data.TOUCH3_XH; //X-coord MSB
-    hid_report_in[14] = tp_data.data.TOUCH3_YL; //Y-coord LSB
-    hid_report_in[15] = tp_data.data.TOUCH3_YH; //Y-coord MSB
-
-    // Touch point 4
-    hid_report_in[16] = ((tp_data.data.TOUCH_POINTS >= 4) ? 3 : 0)
-            | tp_data.data.TOUCH4_ID << 2;
-    hid_report_in[17] = tp_data.data.TOUCH4_XL; //X-coord LSB
-    hid_report_in[18] = tp_data.data.TOUCH4_XH; //X-coord MSB
-    hid_report_in[19] = tp_data.data.TOUCH4_YL; //Y-coord LSB
-    hid_report_in[20] = tp_data.data.TOUCH4_YH; //Y-coord MSB
-
-    // Touch point 5
-    hid_report_in[21] = ((tp_data.data.TOUCH_POINTS >= 5) ? 3 : 0)
-            | tp_data.data.TOUCH5_ID << 2;
-    hid_report_in[22] = tp_data.data.TOUCH5_XL; //X-coord LSB
-    hid_report_in[23] = tp_data.data.TOUCH5_XH; //X-coord MSB
-    hid_report_in[24] = tp_data.data.TOUCH5_YL; //Y-coord LSB
-    hid_report_in[25] = tp_data.data.TOUCH5_YH; //Y-coord MSB
-
-    hid_report_in[26] = tp_data.data.TOUCH_POINTS; // Number of valid contacts
-
-    lastTransmission = HIDTxPacket(HID_EP, (uint8_t*) hid_report_in, 27);
-}
\ No newline at end of file
+    hid_report_in[0] = MULTI_TOUCH_DATA_REPORT_ID; //Report ID in byte[0]
+    hid_report_in[TP_RPT_MULTI_COUNT] = count; // Number of valid contacts
+    tp_multi_slots = active;
+
+    // Both masks are runs from bit 0 once shifted, so stop at the first slot
+    // in neither
+    for (; active | stale; active >>= 1, stale >>= 1) {
+        if (active & 1) {
+            flags = (pts->event != TP_EVENT_UP)
+                    ? TP_RPT_FINGER_TIP | TP_RPT_FINGER_RANGE : 0;
+            if (pts->area < TP_PALM_AREA) flags |= TP_RPT_FINGER_CONFIDENCE;
+            *report++ = flags | pts->id << TP_RPT_FINGER_ID_SHIFT;
+            *report++ = pts->x; //X-coord LSB
+            *report++ = pts->x >> 8; //X-coord MSB
+            *report++ = pts->y; //Y-coord LSB
+            *report++ = pts->y >> 8; //Y-coord MSB
+            size = pts->area * TP_AREA_SCALE;
+            *report++ = size; //Width
+            *report++ = size; //Height
+            pts++;
+        } else {
+            memset(report, 0, TP_RPT_MULTI_FINGER_STRIDE);
+            report += TP_RPT_MULTI_FINGER_STRIDE;
+        }
+    }
+
+    return TP_RPT_MULTI_LEN;
+}
+
+// tp_pack_single() packs both of these
+#if TP_RPT_MOUSE_LEN != TP_RPT_SINGLE_LEN || TP_RPT_MOUSE_BUTTONS != TP_RPT_SINGLE_FLAGS \
+        || TP_RPT_MOUSE_X != TP_RPT_SINGLE_X || TP_RPT_MOUSE_Y != TP_RPT_SINGLE_Y
+#error "The mouse and single-touch input reports no longer share a layout"
+#endif
+
+// Mouse and single-touch: one byte of buttons or tip/in range flags, then
+// X and Y of the primary contact
+static unsigned char tp_pack_single(const touch_point *pts, unsigned char count,
+        unsigned char id, unsigned char down) {
+    const touch_point *pt = tp_primary(pts, count);
+
+    if (!pt) return 0;
+
+    tp_multi_slots |= 0x01; // Overwrites the first finger
+    hid_report_in[0] = id;
+    hid_report_in[TP_RPT_SINGLE_FLAGS] = (pt->event != TP_EVENT_UP) ? down : 0;
+    hid_report_in[TP_RPT_SINGLE_X] = pt->x;
+    hid_report_in[TP_RPT_SINGLE_X + 1] = pt->x >> 8;
+    hid_report_in[TP_RPT_SINGLE_Y] = pt->y;
+    hid_report_in[TP_RPT_SINGLE_Y + 1] = pt->y >> 8;
+    return TP_RPT_SINGLE_LEN;
+}
+
+/**
+ * Populate USB buffer with touch pad data, in the format of the device mode
+ * set by the host
+ *
+ * This should only be called by whatever method is handling USB delegation.
+ * Frames are dropped while the host is changing the device mode.
+ * @param pts Contacts to send
+ * @param count Number of contacts
+ */
+void tp_send(const touch_point *pts, unsigned char count) {
+    unsigned char len;
+    unsigned char mode = APP_DeviceHIDDigitizerMode();
+
+    while (USBHandleBusy(lastTransmission)) {}
+    // Not worth packing a frame that cannot be sent
+    if (USBGetDeviceState() != CONFIGURED_STATE) {
+        lat_drop();
+        return;
+    }
+    lat_mark(LAT_T_PACK_START);
+
+    switch (mode) {
+        case MOUSE_MODE:
+            len = tp_pack_single(pts, count, MOUSE_DATA_REPORT_ID,
+                    TP_RPT_MOUSE_LEFT);
+            break;
+        case SINGLE_TOUCH_DIGITIZER_MODE:
+            len = tp_pack_single(pts, count, SINGLE_TOUCH_DATA_REPORT_ID,
+                    TP_RPT_SINGLE_TIP | TP_RPT_SINGLE_RANGE);
+            break;
+        default:
+#ifdef TP_PACK_BENCH
+            tp_bench_begin();
+            tp_pack_multi_ref(tp_bench_report, pts, count);
+            tp_bench_end(TP_BENCH_PACK_REF);
+            tp_bench_begin();
+#endif
+            len = tp_pack_multi(pts, count);
+#ifdef TP_PACK_BENCH
+            tp_bench_end(TP_BENCH_PACK);
+            if (memcmp(tp_bench_report, hid_report_in, TP_RPT_MULTI_LEN)) {
+                stats.bench[TP_BENCH_MISMATCH]++;
+            }
+#endif
+            break;
+    }
+
+    // Only secondary contacts changed
+    if (!len) {
+        lat_drop();
+        return;
+    }
+    lat_mark(LAT_T_PACK_END);
+
+    // While the host changes the mode EP1 IN must stay disarmed, and a frame
+    // packed in the old format must not follow the switch. Checked with the
+    // USB interrupt masked so that the mode cannot change before arming.
+    USBMaskInterrupts();
+    if (!APP_DeviceHIDDigitizerCanSend() || APP_DeviceHIDDigitizerMode() != mode) {
+        USBUnmaskInterrupts();
+        lat_drop();
+        stats.dropped++;
+        TRACE(TRACE_DROPPED, count);
+        return;
+    }
+#ifdef TP_PACK_BENCH
+    tp_bench_begin();
+    if (tp_bench_tx_ref) {
+        lastTransmission = HIDTxPacket(HID_EP, (uint8_t*) hid_report_in, len);
+        tp_bench_end(TP_BENCH_TX_REF);
+    } else {
+        USBTxOnePacketStatic(lastTransmission, HID_EP, (uint8_t*) hid_report_in, len);
+        tp_bench_end(TP_BENCH_TX);
+    }
+    tp_bench_tx_ref = !tp_bench_tx_ref;
+#else
+    USBTxOnePacketStatic(lastTransmission, HID_EP, (uint8_t*) hid_report_in, len);
+#endif
+    USBUnmaskInterrupts();
+    lat_mark(LAT_T_ARMED);
+    PROBE_ARMED();
+    TRACE(TRACE_REPORT, count);
+    stats.reports++;
+}
@@ -8,12 +8,80 @@
 #ifndef TOUCHPANEL_H
 #define	TOUCHPANEL_H
 
+#include <stdbool.h>
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
+// Native panel resolution and size (units of 0.01 inch)
+#define TP_X_MAX        800
+#define TP_Y_MAX        480
+#define TP_X_PHYS_MAX   429
+#define TP_Y_PHYS_MAX   259
+
+#define TP_MAX_POINTS   5
+#define TP_REG_COUNT    0x21 // Registers read per frame
+#define TP_REG_PMODE    0xA5 // ID_G_PMODE, power mode
+#define TP_REG_FIRMWARE 0xA6 // ID_G_FIRMID
+#define TP_REG_VENDOR   0xA8 // ID_G_FT5201ID, CTPM vendor ID
+
+// Contact size reported to the host, in pixels per TOUCHn_AREA step
+#define TP_AREA_SCALE   8
+// Contacts with at least this TOUCHn_AREA are reported as non-confident palms
+#define TP_PALM_AREA    10
+// Physical extent of the 8-bit Width/Height fields (units of 0.01 inch)
+#define TP_SIZE_PHYS_MAX (255L * TP_X_PHYS_MAX / TP_X_MAX)
+
+// ID_G_PMODE values
+#define TP_PMODE_ACTIVE     0x00
+#define TP_PMODE_MONITOR    0x01 // Slow scan, still interrupts on touch
+#define TP_PMODE_HIBERNATE  0x03 // Only a reset on WAKE brings it back
+
+// Contact events, as reported in TOUCHn_EVENT
+#define TP_EVENT_DOWN       0
+#define TP_EVENT_UP         1
+#define TP_EVENT_CONTACT    2
+
+// Define to time the register unpacking and multi-touch packing against
+// the bitfield versions they replaced, on every frame, and arming the IN
+// endpoint through the stack against the inline version on alternate
+// reports. The results go in the bench counters of the stats feature
+// report (see stats.h).
+//#define TP_PACK_BENCH
+
+// Bench counters, in stats.bench
+#define TP_BENCH_UNPACK_REF 0 // Bitfield unpacking
+#define TP_BENCH_UNPACK     1 // tp_decode() unpacking
+#define TP_BENCH_PACK_REF   2 // Bitfield era packing, every slot written
+#define TP_BENCH_PACK       3 // tp_pack_multi()
+#define TP_BENCH_TX_REF     4 // HIDTxPacket()
+#define TP_BENCH_TX         5 // USBTxOnePacketStatic()
+#define TP_BENCH_MISMATCH   6 // Frames where the two disagreed
+#define TP_BENCHES          7
+
+typedef struct {
+    unsigned XH :4;
+    unsigned :2;
+    unsigned EVENT :2;
+    unsigned char XL;
+    unsigned YH :4;
+    unsigned ID :4;
+    unsigned char YL;
+    unsigned char WEIGHT;
+    unsigned :4;
+    unsigned AREA :4;
+} touch_reg;
+
+// Byte offsets within touch_reg, for unpacking a byte at a time
+#define TP_TOUCH_XH     0 // EVENT in bits 7-6, X bits 11-8 in bits 3-0
+#define TP_TOUCH_XL     1
+#define TP_TOUCH_YH     2 // ID in bits 7-4, Y bits 11-8 in bits 3-0
+#define TP_TOUCH_YL     3
+#define TP_TOUCH_AREA   5 // AREA in bits 7-4
+
 typedef union {
-    unsigned char raw[31];
+    unsigned char raw[TP_REG_COUNT];
     struct {
         unsigned :4;
         unsigned DEVICE_MODE :3;
@@ -27,58 +95,32 @@ typedef union {
                 unsigned TOUCH_POINTS :3;
             };
         };
-        unsigned TOUCH1_XH :4;
-        unsigned :2;
-        unsigned TOUCH1_EVENT :2;
-        unsigned char TOUCH1_XL;
-        unsigned TOUCH1_YH :4;
-        unsigned TOUCH1_ID :4;
-        unsigned char TOUCH1_YL;
-        unsigned :8;
-        unsigned :8;
-        unsigned TOUCH2_XH :4;
-        unsigned :2;
-        unsigned TOUCH2_EVENT :2;
-        unsigned char TOUCH2_XL;
-        unsigned TOUCH2_YH :4;
-        unsigned TOUCH2_ID :4;
-        unsigned char TOUCH2_YL;
-        unsigned :8;
-        unsigned :8;
-        unsigned TOUCH3_XH :4;
-        unsigned :2;
-        unsigned TOUCH3_EVENT :2;
-        unsigned char TOUCH3_XL;
-        unsigned TOUCH3_YH :4;
-        unsigned TOUCH3_ID :4;
-        unsigned char TOUCH3_YL;
-        unsigned :8;
-        unsigned :8;
-        unsigned TOUCH4_XH :4;
-        unsigned :2;
-        unsigned TOUCH4_EVENT :2;
-        unsigned char TOUCH4_XL;
-        unsigned TOUCH4_YH :4;
-        unsigned TOUCH4_ID :4;
-        unsigned char TOUCH4_YL;
-        unsigned :8;
-        unsigned :8;
-        unsigned TOUCH5_XH :4;
-        unsigned :2;
-        unsigned TOUCH5_EVENT :2;
-        unsigned char TOUCH5_XL;
-        unsigned TOUCH5_YH :4;
-        unsigned TOUCH5_ID :4;
-        unsigned char TOUCH5_YL;
+        touch_reg TOUCH[TP_MAX_POINTS];
     } data;
 } touch_data;
 
+// Decoded contact, in report coordinates once transformed
+typedef struct {
+    unsigned int x;
+    unsigned int y;
+    unsigned char id;
+    unsigned char event;
+    unsigned char area;
+} touch_point;
+
+void tp_isr(void);
 void tp_service(void);
 void tp_init(void);
+void tp_wake(void);
 void tp_enable(void);
 void tp_disable(void);
+void tp_suspend(bool monitor);
+void tp_resume(void);
+unsigned char tp_read_reg(unsigned char reg);
+void tp_write_reg(unsigned char reg, unsigned char value);
 void tp_read(void);
-void tp_send(void);
+void tp_decode(void);
+void tp_send(const touch_point *pts, unsigned char count);
 
 
 #ifdef	__cplusplus
@@ -0,0 +1,102 @@
+#include <xc.h>
+#include "trace.h"
+
+#ifdef TRACE_ENABLE
+
+#define TRACE_MASK      (TRACE_RECORDS - 1)
+#define TRACE_BRG       (TRACE_FOSC / 4 / TRACE_BAUD - 1)
+
+typedef struct {
+    unsigned char id;
+    unsigned char arg;
+    unsigned int time; // Timer1 count
+} trace_rec;
+
+static trace_rec trace_ring[TRACE_RECORDS];
+static unsigned char trace_head; // Next record to write
+static unsigned char trace_tail; // Record being sent
+static unsigned char trace_byte; // Next byte of it, 0 is the sync byte
+static unsigned char trace_lost;
+
+void trace_init(void) {
+    ANSELHbits.ANS11 = 0; // RB5 is RX, left unused
+    SPBRGH = TRACE_BRG >> 8;
+    SPBRG = TRACE_BRG & 0xFF;
+    BAUDCONbits.BRG16 = 1;
+    TXSTAbits.BRGH = 1;
+    TXSTAbits.SYNC = 0;
+    RCSTAbits.SPEN = 1;
+    TXSTAbits.TXEN = 1;
+    IPR1bits.TXIP = 0; // Low priority
+
+    trace_put(TRACE_BOOT, RCON);
+}
+
+static void trace_write(unsigned char id, unsigned char arg, unsigned int time) {
+    trace_rec *r = &trace_ring[trace_head];
+
+    r->id = id;
+    r->arg = arg;
+    r->time = time;
+    trace_head = (trace_head + 1) & TRACE_MASK;
+}
+
+/**
+ * Log a record
+ *
+ * Safe to call from either interrupt. Both priorities are masked for the
+ * few instructions it takes to claim and fill the slot; sending is left to
+ * trace_isr().
+ * @param id TRACE_* record id
+ * @param arg
+ */
+void trace_put(unsigned char id, unsigned char arg) {
+    unsigned char gieh = INTCONbits.GIEH;
+    unsigned char room;
+    unsigned int time;
+
+    INTCONbits.GIEH = 0;
+    time = TMR1L; // Latches TMR1H
+    time |= (unsigned int) TMR1H << 8;
+
+    // The slot at the tail is still being sent
+    room = (trace_tail - trace_head - 1) & TRACE_MASK;
+    if (room < (trace_lost ? 2 : 1)) {
+        if (trace_lost != 0xFF) trace_lost++;
+    } else {
+        if (trace_lost) {
+            trace_write(TRACE_LOST, trace_lost, time);
+            trace_lost = 0;
+        }
+        trace_write(id, arg, time);
+        PIE1bits.TXIE = 1;
+    }
+    INTCONbits.GIEH = gieh;
+}
+
+/**
+ * Send the next byte of the ring
+ *
+ * Called from the low-priority interrupt. The TX interrupt is turned off
+ * once the ring is empty and back on by trace_put().
+ */
+void trace_isr(void) {
+    if (!PIE1bits.TXIE || !PIR1bits.TXIF) return;
+
+    if (trace_tail == trace_head) {
+        PIE1bits.TXIE = 0;
+        return;
+    }
+
+    if (trace_byte == 0) {
+        TXREG = TRACE_SYNC;
+    } else {
+        TXREG = ((unsigned char *) &trace_ring[trace_tail])[trace_byte - 1];
+    }
+    if (++trace_byte > sizeof (trace_rec)) {
+        trace_byte = 0;
+        trace_tail = (trace_tail + 1) & TRACE_MASK;
+    }
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * File:   trace.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TRACE_H
+#define	TRACE_H
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Define to log trace records to a RAM ring, drained through the EUSART
+// on RB7 (TX) by the low-priority interrupt. Decode the output with
+// tools/trace_decode.py. Undefined, the TRACE macros expand to nothing.
+//#define TRACE_ENABLE
+
+// Ring size in records, a power of two. Records logged while the ring is
+// full are counted and reported with a TRACE_LOST record.
+#ifndef TRACE_RECORDS
+#define TRACE_RECORDS   16
+#endif
+
+// Line rate. With BRG16 and BRGH set the divider is Fosc / 4 / baud, so
+// rates that divide 12 MHz are exact.
+#ifndef TRACE_BAUD
+#define TRACE_BAUD      1000000UL
+#endif
+#define TRACE_FOSC      48000000UL
+
+// Each record goes out as TRACE_SYNC, id, arg, then the Timer1 count at
+// the time it was logged, low byte first (TICK_FAST_PER_US per us).
+#define TRACE_SYNC      0xA5
+
+// Record ids, the argument is noted where there is one
+#define TRACE_BOOT      0x01 // RCON
+#define TRACE_BOOT_STAGE 0x02 // BOOT_STAGE_*
+#define TRACE_INT       0x03 // INT1 seen
+#define TRACE_FRAME     0x04 // Frame decoded, raw contact count
+#define TRACE_REPORT    0x05 // Input report armed, contact count
+#define TRACE_IN_DONE   0x06 // Host collected the input report
+#define TRACE_DROPPED   0x07 // Frame with contacts not sent
+#define TRACE_I2C_ERR   0x08 // I2C_ERR_* flags
+#define TRACE_BUS_ERR   0x09 // UEIR
+#define TRACE_SUSPEND   0x0A
+#define TRACE_RESUME    0x0B
+#define TRACE_WAKEUP    0x0C // Remote wakeup signalled
+#define TRACE_SET_REPORT 0x0D // Report id applied from the host
+#define TRACE_CFG_SAVE  0x0E // Configuration slot written
+#define TRACE_LOST      0x7F // Records dropped, saturates at 255
+
+#ifdef TRACE_ENABLE
+#define TRACE_INIT()        trace_init()
+#define TRACE(id, arg)      trace_put((id), (arg))
+#define TRACE_ISR()         trace_isr()
+#else
+#define TRACE_INIT()
+#define TRACE(id, arg)
+#define TRACE_ISR()
+#endif
+
+void trace_init(void);
+void trace_put(unsigned char id, unsigned char arg);
+void trace_isr(void);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TRACE_H */
+
@@ -0,0 +1,117 @@
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "transform.h"
+#include "settings.h"
+
+#ifdef TF_CALIBRATION
+static bool tf_calibrated;
+static bool tf_scale_only;
+static int16_t tf_matrix[6];
+#endif
+
+/**
+ * Load the calibration matrix from the configuration store
+ *
+ * Calibration stays disabled until a matrix has been stored, so a freshly
+ * programmed board reports the oriented coordinates unchanged. Call again
+ * after the configuration changes.
+ */
+void tf_init(void) {
+#ifdef TF_CALIBRATION
+    unsigned char i;
+
+    tf_calibrated = false;
+    if (!(cfg.tf_flags & CFG_TF_CALIBRATED)) return;
+
+    for (i = 0; i < 6; i++) {
+        tf_matrix[i] = cfg.tf_matrix[i];
+    }
+
+    // Pure offset/scale matrices skip the cross terms
+    tf_scale_only = (tf_matrix[1] == 0 && tf_matrix[3] == 0);
+    tf_calibrated = true;
+#endif
+}
+
+/**
+ * Check a calibration matrix from the host before it is used
+ *
+ * Rejects matrices that would leave part of the screen out of reach:
+ * ones that shrink the panel below a quarter of its area, flip it onto a
+ * line, or move its centre outside the report range.
+ * @param m Six Q12 coefficients, as in cfg_settings.tf_matrix
+ * @return
+ */
+bool tf_check(const int16_t *m) {
+    int32_t det;
+    int32_t x;
+    int32_t y;
+
+    // Halved so the difference of two Q24 products cannot overflow
+    det = ((int32_t) m[0] * m[4] >> 1) - ((int32_t) m[1] * m[3] >> 1);
+    if (det < 0) det = -det;
+    if (det < (1L << (2 * TF_FRAC_BITS - 3))) return false;
+
+    x = (((int32_t) m[0] * (TF_X_MAX / 2) + (int32_t) m[1] * (TF_Y_MAX / 2))
+            >> TF_FRAC_BITS) + m[2];
+    y = (((int32_t) m[3] * (TF_X_MAX / 2) + (int32_t) m[4] * (TF_Y_MAX / 2))
+            >> TF_FRAC_BITS) + m[5];
+    return x >= 0 && x <= TF_X_MAX && y >= 0 && y <= TF_Y_MAX;
+}
+
+#ifdef TF_CALIBRATION
+static unsigned int tf_clamp(int32_t v, unsigned int max) {
+    if (v < 0) return 0;
+    if (v > (int32_t) max) return max;
+    return (unsigned int) v;
+}
+#endif
+
+/**
+ * Map a decoded contact from panel coordinates to report coordinates
+ * @param pt
+ */
+void tf_apply(touch_point *pt) {
+#if TF_ORIENTATION & TF_SWAP_XY
+    unsigned int tmp;
+
+    tmp = pt->x;
+    pt->x = pt->y;
+    pt->y = tmp;
+#endif
+    // The controller can report a little past the panel edge, which would
+    // wrap when inverted and fall outside the descriptor's logical range
+    if (pt->x > TF_X_MAX) pt->x = TF_X_MAX;
+    if (pt->y > TF_Y_MAX) pt->y = TF_Y_MAX;
+#if TF_ORIENTATION & TF_INVERT_X
+    pt->x = TF_X_MAX - pt->x;
+#endif
+#if TF_ORIENTATION & TF_INVERT_Y
+    pt->y = TF_Y_MAX - pt->y;
+#endif
+
+#ifdef TF_CALIBRATION
+    if (!tf_calibrated) return;
+
+    {
+        int32_t x = pt->x;
+        int32_t y = pt->y;
+        int32_t nx;
+        int32_t ny;
+
+        if (tf_scale_only) {
+            nx = (int32_t) tf_matrix[0] * x;
+            ny = (int32_t) tf_matrix[4] * y;
+        } else {
+            nx = (int32_t) tf_matrix[0] * x + (int32_t) tf_matrix[1] * y;
+            ny = (int32_t) tf_matrix[3] * x + (int32_t) tf_matrix[4] * y;
+        }
+        nx = ((nx + (1 << (TF_FRAC_BITS - 1))) >> TF_FRAC_BITS) + tf_matrix[2];
+        ny = ((ny + (1 << (TF_FRAC_BITS - 1))) >> TF_FRAC_BITS) + tf_matrix[5];
+
+        pt->x = tf_clamp(nx, TF_X_MAX);
+        pt->y = tf_clamp(ny, TF_Y_MAX);
+    }
+#endif
+}
@@ -0,0 +1,61 @@
+/*
+ * File:   transform.h
+ *
+ * Created on October 19, 2026
+ */
+
+#ifndef TRANSFORM_H
+#define	TRANSFORM_H
+
+#include <stdint.h>
+#include "touchpanel.h"
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+// Orientation flags. The swap is applied first, then the inversions.
+#define TF_SWAP_XY      0x01
+#define TF_INVERT_X     0x02
+#define TF_INVERT_Y     0x04
+
+// Panel mounting orientation. This is fixed at compile time since swapping
+// the axes changes the logical extents in the report descriptor.
+#ifndef TF_ORIENTATION
+#define TF_ORIENTATION  0
+#endif
+
+// Define to apply the affine calibration matrix from the configuration
+// store after the orientation step. Leave undefined for orientation-only
+// builds, which need no multiplies at all.
+//#define TF_CALIBRATION
+
+// The matrix is six Q12 coefficients A B C D E F, where
+//   x' = (A*x + B*y) / 4096 + C
+//   y' = (D*x + E*y) / 4096 + F
+// The bottom row of the 3x3 matrix is always [0 0 1] and is not stored.
+#define TF_FRAC_BITS    12
+
+// Logical extents of the reported coordinates
+#if TF_ORIENTATION & TF_SWAP_XY
+#define TF_X_MAX        TP_Y_MAX
+#define TF_Y_MAX        TP_X_MAX
+#define TF_X_PHYS_MAX   TP_Y_PHYS_MAX
+#define TF_Y_PHYS_MAX   TP_X_PHYS_MAX
+#else
+#define TF_X_MAX        TP_X_MAX
+#define TF_Y_MAX        TP_Y_MAX
+#define TF_X_PHYS_MAX   TP_X_PHYS_MAX
+#define TF_Y_PHYS_MAX   TP_Y_PHYS_MAX
+#endif
+
+void tf_init(void);
+bool tf_check(const int16_t *m);
+void tf_apply(touch_point *pt);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* TRANSFORM_H */
+
@@ -237,6 +237,18 @@ static void USBConfigureEndpoint(uint8_t EPNum, uint8_t direction);
 static void USBWakeFromSuspend(void);
 static void USBSuspend(void);
 static void USBStallHandler(void);
+static void USBSOFTasks(void);
+
+#if defined(USB_ENABLE_ISR_FAST_PATH)
+    #if !defined(__18CXX) && !defined(__XC8)
+        #error "The USBDeviceTasks() fast path only knows the PIC18 USB registers"
+    #endif
+    //UIR flags the fast path leaves to the full dispatch: STALLIF, IDLEIF,
+    //ACTVIF, UERRIF and URSTIF
+    #define USB_FAST_PATH_OTHER_IF  0x37
+    //USTAT ENDP bits
+    #define USB_FAST_PATH_ENDP_MASK 0x78
+#endif
 
 // *****************************************************************************
 // *****************************************************************************
@@ -490,6 +502,53 @@ void USBDeviceTasks(void)
 {
     uint8_t i;
 
+#if defined(USB_ENABLE_ISR_FAST_PATH)
+    /*
+     * Fast path: once configured, almost every interrupt is a SOF or the
+     * completion of a transaction on an endpoint other than EP0.  Service
+     * those here and skip the full dispatch, unless some other enabled
+     * interrupt is pending or the USTAT FIFO reaches an EP0 transaction.
+     */
+    if((USBDeviceState == CONFIGURED_STATE) && (USBSuspendControl == 0)
+        && ((U1IR & U1IE & USB_FAST_PATH_OTHER_IF) == 0))
+    {
+        if(USBSOFIF)
+        {
+            USBSOFTasks();
+        }
+
+        while(USBTransactionCompleteIF)
+        {
+            if((U1STAT & USB_FAST_PATH_ENDP_MASK) == 0)
+            {
+                break;  //EP0, left to USBCtrlEPService() below
+            }
+            USTATcopy.Val = U1STAT;
+            endpoint_number = USBHALGetLastEndpoint(USTATcopy);
+            USBClearInterruptFlag(USBTransactionCompleteIFReg,USBTransactionCompleteIFBitNum);
+
+            #if (USB_PING_PONG_MODE == USB_PING_PONG__ALL_BUT_EP0) || (USB_PING_PONG_MODE == USB_PING_PONG__FULL_PING_PONG)
+            if(USBHALGetLastDirection(USTATcopy) == OUT_FROM_HOST)
+            {
+                ep_data_out[endpoint_number].bits.ping_pong_state ^= 1;
+            }
+            else
+            {
+                ep_data_in[endpoint_number].bits.ping_pong_state ^= 1;
+            }
+            #endif
+
+            USB_TRANSFER_COMPLETE_HANDLER(EVENT_TRANSFER, (uint8_t*)&USTATcopy.Val, 0);
+        }
+
+        if(USBTransactionCompleteIF == 0)
+        {
+            USBClearUSBInterrupt();
+            return;
+        }
+    }
+#endif
+
 #ifdef USB_SUPPORT_OTG
     //SRP Time Out Check
     if (USBOTGSRPIsReady())
@@ -703,49 +762,7 @@ void USBDeviceTasks(void)
 
     if(USBSOFIF)
     {
-        if(USBSOFIE)
-        {
-            USB_SOF_HANDLER(EVENT_SOF,0,1);
-        }    
-        USBClearInterruptFlag(USBSOFIFReg,USBSOFIFBitNum);
-        
-        #if defined(USB_ENABLE_STATUS_STAGE_TIMEOUTS)
-            //Supporting this feature requires a 1ms timebase for keeping track of the timeout interval.
-            #if(USB_SPEED_OPTION == USB_LOW_SPEED)
-                #warning "Double click this message.  See inline code comments."
-                //The "USB_ENABLE_STATUS_STAGE_TIMEOUTS" feature is optional and is
-                //not strictly needed in all applications (ex: those that never call 
-                //USBDeferStatusStage() and don't use host to device (OUT) control
-                //transfers with data stage).  
-                //However, if this feature is enabled and used, it requires a timer 
-                //(preferrably 1ms) to decrement the USBStatusStageTimeoutCounter.  
-                //In USB Full Speed applications, the host sends Start-of-Frame (SOF) 
-                //packets at a 1ms rate, which generates SOFIF interrupts.
-                //These interrupts can be used to decrement USBStatusStageTimeoutCounter as shown 
-                //below.  However, the host does not send SOF packets to Low Speed devices.  
-                //Therefore, some other method  (ex: using a general purpose microcontroller 
-                //timer, such as Timer0) needs to be implemented to call and execute the below code
-                //at a once/1ms rate, in a low speed USB application.
-                //Note: Pre-condition to executing the below code: USBDeviceInit() should have
-                //been called at least once (since the last microcontroller reset/power up), 
-                //prior to executing the below code.
-            #endif
-            
-            //Decrement our status stage counter.
-            if(USBStatusStageTimeoutCounter != 0u)
-            {
-                USBStatusStageTimeoutCounter--;
-            }
-            //Check if too much time has elapsed since progress was made in 
-            //processing the control transfer, without arming the status stage.  
-            //If so, auto-arm the status stage to ensure that the control 
-            //transfer can [eventually] complete, within the timing limits
-            //dictated by section 9.2.6 of the official USB 2.0 specifications.
-            if(USBStatusStageTimeoutCounter == 0)
-            {
-                USBCtrlEPAllowStatusStage();    //Does nothing if the status stage was already armed.
-            } 
-        #endif
+        USBSOFTasks();
     }
 
     if(USBStallIF && USBStallIE)
@@ -826,6 +843,69 @@ void USBDeviceTasks(void)
     USBClearUSBInterrupt();
 }//end of USBDeviceTasks()
 
+/********************************************************************
+ * Function:        static void USBSOFTasks(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Side Effects:    None
+ *
+ * Overview:        Services a start of frame interrupt.  Called from both
+ *                  the full USBDeviceTasks() dispatch and its fast path.
+ *
+ * Note:            None
+ *******************************************************************/
+static void USBSOFTasks(void)
+{
+    if(USBSOFIE)
+    {
+        USB_SOF_HANDLER(EVENT_SOF,0,1);
+    }    
+    USBClearInterruptFlag(USBSOFIFReg,USBSOFIFBitNum);
+    
+    #if defined(USB_ENABLE_STATUS_STAGE_TIMEOUTS)
+        //Supporting this feature requires a 1ms timebase for keeping track of the timeout interval.
+        #if(USB_SPEED_OPTION == USB_LOW_SPEED)
+            #warning "Double click this message.  See inline code comments."
+            //The "USB_ENABLE_STATUS_STAGE_TIMEOUTS" feature is optional and is
+            //not strictly needed in all applications (ex: those that never call 
+            //USBDeferStatusStage() and don't use host to device (OUT) control
+            //transfers with data stage).  
+            //However, if this feature is enabled and used, it requires a timer 
+            //(preferrably 1ms) to decrement the USBStatusStageTimeoutCounter.  
+            //In USB Full Speed applications, the host sends Start-of-Frame (SOF) 
+            //packets at a 1ms rate, which generates SOFIF interrupts.
+            //These interrupts can be used to decrement USBStatusStageTimeoutCounter as shown 
+            //below.  However, the host does not send SOF packets to Low Speed devices.  
+            //Therefore, some other method  (ex: using a general purpose microcontroller 
+            //timer, such as Timer0) needs to be implemented to call and execute the below code
+            //at a once/1ms rate, in a low speed USB application.
+            //Note: Pre-condition to executing the below code: USBDeviceInit() should have
+            //been called at least once (since the last microcontroller reset/power up), 
+            //prior to executing the below code.
+        #endif
+        
+        //Decrement our status stage counter.
+        if(USBStatusStageTimeoutCounter != 0u)
+        {
+            USBStatusStageTimeoutCounter--;
+        }
+        //Check if too much time has elapsed since progress was made in 
+        //processing the control transfer, without arming the status stage.  
+        //If so, auto-arm the status stage to ensure that the control 
+        //transfer can [eventually] complete, within the timing limits
+        //dictated by section 9.2.6 of the official USB 2.0 specifications.
+        if(USBStatusStageTimeoutCounter == 0)
+        {
+            USBCtrlEPAllowStatusStage();    //Does nothing if the status stage was already armed.
+        } 
+    #endif
+}
+
 /*******************************************************************************
   Function:
         void USBEnableEndpoint(uint8_t ep, uint8_t options)
@@ -1693,6 +1693,76 @@ USB_HANDLE USBTxOnePacket(uint8_t ep, uint8_t* data, uint16_t len);
 #define USBTxOnePacket(ep,data,len)     USBTransferOnePacket(ep,IN_TO_HOST,data,len)
 /*DOM-IGNORE-END*/
 
+/********************************************************************
+    Function:
+        void USBTxOnePacketStatic(USB_HANDLE handle, uint8_t ep, uint8_t* data, uint8_t len)
+
+    Summary:
+        Sends the specified data out the specified endpoint, with the
+        endpoint fixed at compile time
+
+    Description:
+        Does what USBTxOnePacket() does, expanded in place for a constant
+        IN endpoint.  The BDT pointer is read from a fixed address, the
+        ping-pong and data toggle handling for the configured
+        USB_PING_PONG_MODE is chosen by the preprocessor, and the STAT byte
+        is written once with UOWN set instead of being modified three times.
+        Like USBTxOnePacket(), it sends nothing and gives a null handle if
+        the endpoint has not been configured, or was reset by the USB
+        interrupt since the caller last checked.
+
+        Typical Usage:
+        <code>
+        if(!USBHandleBusy(USBInHandle))
+        {
+            USBTxOnePacketStatic(USBInHandle, HID_EP, (uint8_t*)&ToSendDataBuffer[0], sizeof(ToSendDataBuffer));
+        }
+        </code>
+
+    PreCondition:
+        The endpoint's previous transfer is done
+
+    Parameters:
+        handle - USB_HANDLE variable assigned the BDT entry of the transfer
+        ep - constant endpoint number you want to send the data out of
+        data - pointer to a buffer the USB module can access
+        len - the number of bytes to send, up to the endpoint size
+
+    Return Values:
+        None
+
+    Remarks:
+        PIC18 only.  ep is evaluated more than once.
+
+ *******************************************************************/
+#if (defined(__18CXX) || defined(__XC8)) && !defined(_PIC14E)
+/*DOM-IGNORE-BEGIN*/
+#if (USB_PING_PONG_MODE == USB_PING_PONG__NO_PING_PONG) || (USB_PING_PONG_MODE == USB_PING_PONG__EP0_OUT_ONLY)
+    #define USB_STATIC_TX_TOGGLE    _DTSMASK    //One BDT entry, toggle DATA0/1 in it
+    #define USB_STATIC_TX_NEXT      0x00
+#else
+    #define USB_STATIC_TX_TOGGLE    0x00        //Even and odd entries keep their own toggle
+    #define USB_STATIC_TX_NEXT      sizeof(BDT_ENTRY)
+#endif
+#if defined(USB_DEVICE_DISABLE_DTS_CHECKING)
+    #define USB_STATIC_TX_DTSEN     0x00
+#else
+    #define USB_STATIC_TX_DTSEN     _DTSEN
+#endif
+#define USBTxOnePacketStatic(handle,ep,data,len) {\
+    volatile BDT_ENTRY* pBDT_ = pBDTEntryIn[ep];\
+    if(pBDT_ != 0)\
+    {\
+        pBDT_->ADR = ConvertToPhysicalAddress(data);\
+        pBDT_->CNT = (len);\
+        pBDT_->STAT.Val = ((pBDT_->STAT.Val ^ USB_STATIC_TX_TOGGLE) & _DTSMASK) | USB_STATIC_TX_DTSEN | _USIE;\
+        ((uint8_t*)&pBDTEntryIn[ep])[0] ^= USB_STATIC_TX_NEXT;\
+    }\
+    (handle) = (USB_HANDLE)pBDT_;\
+}
+/*DOM-IGNORE-END*/
+#endif
+
 /********************************************************************
     Function:
         USB_HANDLE USBRxOnePacket(uint8_t ep, uint8_t* data, uint16_t len)
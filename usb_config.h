@@ -47,6 +47,8 @@
 #ifndef USBCFG_H
 #define USBCFG_H
 
+#include "hid_layout.h"
+
 /** DEFINITIONS ****************************************************/
 #define USB_EP0_BUFF_SIZE		8	// Valid Options: 8, 16, 32, or 64 bytes.
 								// Using larger options take more SRAM, but
@@ -54,6 +56,10 @@
 								// of applications.  Exceptions to this, are applications
 								// that use EP0 IN or OUT for sending large amounts of
 								// application related data.
+								// 64 fetches the report descriptor in 10
+								// transactions instead of 79, but fills the
+								// whole of USB RAM (fixed_address_memory.h has
+								// layouts for 8 and 64), so it is opt-in.
 
 #define USB_MAX_NUM_INT     	1   // For tracking Alternate Setting
 #define USB_MAX_EP_NUMBER	    1
@@ -144,16 +150,19 @@
 #define USB_NUM_STRING_DESCRIPTORS 3
 
 //#define USB_INTERRUPT_LEGACY_CALLBACKS
-#define USB_ENABLE_ALL_HANDLERS
-//#define USB_ENABLE_SUSPEND_HANDLER
-//#define USB_ENABLE_WAKEUP_FROM_SUSPEND_HANDLER
-//#define USB_ENABLE_SOF_HANDLER
-//#define USB_ENABLE_ERROR_HANDLER
-//#define USB_ENABLE_OTHER_REQUEST_HANDLER
-//#define USB_ENABLE_SET_DESCRIPTOR_HANDLER
-//#define USB_ENABLE_INIT_EP_HANDLER
-//#define USB_ENABLE_EP0_DATA_HANDLER
-//#define USB_ENABLE_TRANSFER_COMPLETE_HANDLER
+
+//Event handlers: every event is passed to USER_USB_CALLBACK_EVENT_HANDLER
+//unless compiled out here (see usb/src/usb_device_local.h).  The device uses
+//SOF, transfer complete, bus error, suspend, resume, set configuration and
+//non-standard EP0 requests, and nothing else.
+#define USB_DISABLE_SET_DESCRIPTOR_HANDLER
+#define USB_DISABLE_TRANSFER_TERMINATED_HANDLER
+
+//Once configured, service SOF and EP1 transaction complete interrupts without
+//the full USBDeviceTasks() dispatch, falling back to it for anything else.
+//Comment out to compare; the stats feature report has the time spent in the
+//high priority interrupt.
+#define USB_ENABLE_ISR_FAST_PATH
 
 /** DEVICE CLASS USAGE *********************************************/
 #define USB_USE_HID
@@ -163,10 +172,10 @@
 /* HID */
 #define HID_INTF_ID             0x00
 #define HID_EP 					1
-#define HID_INT_OUT_EP_SIZE     64
+#define HID_INT_OUT_EP_SIZE     32  // Largest SET_REPORT accepted on EP0, there is no OUT endpoint
 #define HID_INT_IN_EP_SIZE      64
 #define HID_NUM_OF_DSC          1
-#define HID_RPT01_SIZE          330u
+// HID_RPT01_SIZE is in hid_layout.h, generated with the report descriptor
 #define USER_GET_REPORT_HANDLER UserGetReportHandler
 #define USER_SET_REPORT_HANDLER UserSetReportHandler
 
@@ -177,6 +186,22 @@
 #define MULTI_TOUCH_DATA_REPORT_ID			(uint8_t)0x01
 #define VALID_CONTACTS_FEATURE_REPORT_ID	(uint8_t)0x02
 #define DEVICE_MODE_FEATURE_REPORT_ID		(uint8_t)0x03
+#define BRIGHTNESS_FEATURE_REPORT_ID		(uint8_t)0x04
+#define CONFIG_FEATURE_REPORT_ID			(uint8_t)0x05
+#define BOOT_FEATURE_REPORT_ID				(uint8_t)0x06
+#define STATS_FEATURE_REPORT_ID				(uint8_t)0x07
+#define LATENCY_FEATURE_REPORT_ID			(uint8_t)0x08
+#define SYNTH_FEATURE_REPORT_ID				(uint8_t)0x09
+#define MOUSE_DATA_REPORT_ID				(uint8_t)0x0A
+#define SINGLE_TOUCH_DATA_REPORT_ID			(uint8_t)0x0B
+
+//Device Mode values, set by the host through DEVICE_MODE_FEATURE_REPORT_ID.
+//Hosts that know about multi-touch switch to it while they start up, anything
+//else is left with the default, a plain absolute mouse.
+#define MOUSE_MODE                          (uint8_t)0x00
+#define SINGLE_TOUCH_DIGITIZER_MODE         (uint8_t)0x01
+#define MULTI_TOUCH_DIGITIZER_MODE          (uint8_t)0x02
+#define DEFAULT_DEVICE_MODE                 MOUSE_MODE
 
 //Other Definitions
 #define MAX_VALID_CONTACT_POINTS            (uint8_t)0x05
@@ -162,6 +162,12 @@ state according to the definition in the USB specification.
 /** INCLUDES *******************************************************/
 #include <usb/usb.h>
 #include <usb/usb_device_hid.h>
+#include "transform.h"
+#include "settings.h"
+#include "boot.h"
+#include "stats.h"
+#include "latency.h"
+#include "synth.h"
 
 /** CONSTANTS ******************************************************/
 #if defined(COMPILER_MPLAB_C18)
@@ -284,15 +290,29 @@ sizeof(sd002),USB_DESCRIPTOR_STRING,
 //has Y coordinate = 0.  The bottom most part of the screen has Y coordinate = 3000 for this
 //example HID report descriptor.
 
+//NOTE (Encoding): The descriptor is fetched over EP0 during every enumeration.
+//Global items are only repeated where the value in force has to change, so
+//each collection inherits the usage page and logical minimum left by the one
+//above it.  The position and size fields, the only ones with units and
+//physical extents, are wrapped in PUSH/POP so that the counts, flags and
+//buttons after them are unitless without clearing the units again.  This
+//brings the descriptor down from 648 to 626 bytes.
+//
+//The descriptor below and hid_layout.h are generated by tools/hid_layout.py.
+//Change the report table there and run it again rather than editing either by
+//hand; hid_layout.py --check verifies that the two still match the table.
+
 const struct{uint8_t report[HID_RPT01_SIZE];}hid_rpt01={
     {
 /* Data format:
  * |  7  |  6  |  5  |  4  |  3  |  2  |  1  |  0  |
- * | Contact Identifier                |Range| Tip |
+ * | Contact Identifier          |Conf |Range| Tip |
  * | X L                                           |
  * |   H                                           |
  * | Y L                                           |
  * |   H                                           |
+ * | Width                                         |
+ * | Height                                        |
  * ... 5 times
  * | Contact Count                                 |
  */
@@ -304,160 +324,320 @@ const struct{uint8_t report[HID_RPT01_SIZE];}hid_rpt01={
     0xa1, 0x02,                    //   COLLECTION (Logical)
     0x09, 0x42,                    //     USAGE (Tip Switch)
     0x09, 0x32,                    //     USAGE (In Range)
+    0x09, 0x47,                    //     USAGE (Confidence)
     0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
     0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
+    0x45, 0x00,                    //     PHYSICAL_MAXIMUM (0)
+    0x55, 0x00,                    //     UNIT_EXPONENT (0)
+    0x65, 0x00,                    //     UNIT (None)
     0x75, 0x01,                    //     REPORT_SIZE (1)
-    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x75, 0x06,                    //     REPORT_SIZE (6)
-    0x95, 0x01,                    //     REPORT_COUNT (1)
-    0x25, 0x3f,                    //     LOGICAL_MAXIMUM (63)
     0x09, 0x51,                    //     USAGE (Contact Identifier)
+    0x25, 0x1f,                    //     LOGICAL_MAXIMUM (31)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xa4,                          //     PUSH
     0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
-    0x75, 0x10,                    //     REPORT_SIZE (16)
-    0x26, 0x20, 0x03,              //     LOGICAL_MAXIMUM (800)
-    0x46, 0xad, 0x01,              //     PHYSICAL_MAXIMUM (429)
+    0x09, 0x30,                    //     USAGE (X)
+    0x26, DESC_CONFIG_WORD(TF_X_MAX),        //     LOGICAL_MAXIMUM (TF_X_MAX)
+    0x46, DESC_CONFIG_WORD(TF_X_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_X_PHYS_MAX)
     0x55, 0x0e,                    //     UNIT_EXPONENT (-2)
     0x65, 0x33,                    //     UNIT (Eng Lin:0x33)
-    0x09, 0x30,                    //     USAGE (X)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x26, 0xe0, 0x01,              //     LOGICAL_MAXIMUM (480)
-    0x46, 0x03, 0x01,              //     PHYSICAL_MAXIMUM (259)
     0x09, 0x31,                    //     USAGE (Y)
+    0x26, DESC_CONFIG_WORD(TF_Y_MAX),        //     LOGICAL_MAXIMUM (TF_Y_MAX)
+    0x46, DESC_CONFIG_WORD(TF_Y_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_Y_PHYS_MAX)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x05, 0x0d,                    //     USAGE_PAGE (Digitizers)
+    0x09, 0x48,                    //     USAGE (Width)
+    0x09, 0x49,                    //     USAGE (Height)
+    0x26, 0xff, 0x00,              //     LOGICAL_MAXIMUM (255)
+    0x46, DESC_CONFIG_WORD(TP_SIZE_PHYS_MAX), //     PHYSICAL_MAXIMUM (TP_SIZE_PHYS_MAX)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xb4,                          //     POP
     0xc0,                          //   END_COLLECTION
-    0x05, 0x0d,                    //   USAGE_PAGE (Digitizers)
     0x09, 0x22,                    //   USAGE (Finger)
     0xa1, 0x02,                    //   COLLECTION (Logical)
     0x09, 0x42,                    //     USAGE (Tip Switch)
     0x09, 0x32,                    //     USAGE (In Range)
-    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x09, 0x47,                    //     USAGE (Confidence)
     0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
     0x75, 0x01,                    //     REPORT_SIZE (1)
-    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x75, 0x06,                    //     REPORT_SIZE (6)
-    0x95, 0x01,                    //     REPORT_COUNT (1)
-    0x25, 0x3f,                    //     LOGICAL_MAXIMUM (63)
     0x09, 0x51,                    //     USAGE (Contact Identifier)
+    0x25, 0x1f,                    //     LOGICAL_MAXIMUM (31)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xa4,                          //     PUSH
     0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
-    0x75, 0x10,                    //     REPORT_SIZE (16)
-    0x26, 0x20, 0x03,              //     LOGICAL_MAXIMUM (800)
-    0x46, 0xad, 0x01,              //     PHYSICAL_MAXIMUM (429)
+    0x09, 0x30,                    //     USAGE (X)
+    0x26, DESC_CONFIG_WORD(TF_X_MAX),        //     LOGICAL_MAXIMUM (TF_X_MAX)
+    0x46, DESC_CONFIG_WORD(TF_X_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_X_PHYS_MAX)
     0x55, 0x0e,                    //     UNIT_EXPONENT (-2)
     0x65, 0x33,                    //     UNIT (Eng Lin:0x33)
-    0x09, 0x30,                    //     USAGE (X)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x26, 0xe0, 0x01,              //     LOGICAL_MAXIMUM (480)
-    0x46, 0x03, 0x01,              //     PHYSICAL_MAXIMUM (259)
     0x09, 0x31,                    //     USAGE (Y)
+    0x26, DESC_CONFIG_WORD(TF_Y_MAX),        //     LOGICAL_MAXIMUM (TF_Y_MAX)
+    0x46, DESC_CONFIG_WORD(TF_Y_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_Y_PHYS_MAX)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x05, 0x0d,                    //     USAGE_PAGE (Digitizers)
+    0x09, 0x48,                    //     USAGE (Width)
+    0x09, 0x49,                    //     USAGE (Height)
+    0x26, 0xff, 0x00,              //     LOGICAL_MAXIMUM (255)
+    0x46, DESC_CONFIG_WORD(TP_SIZE_PHYS_MAX), //     PHYSICAL_MAXIMUM (TP_SIZE_PHYS_MAX)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xb4,                          //     POP
     0xc0,                          //   END_COLLECTION
-    0x05, 0x0d,                    //   USAGE_PAGE (Digitizers)
     0x09, 0x22,                    //   USAGE (Finger)
     0xa1, 0x02,                    //   COLLECTION (Logical)
     0x09, 0x42,                    //     USAGE (Tip Switch)
     0x09, 0x32,                    //     USAGE (In Range)
-    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x09, 0x47,                    //     USAGE (Confidence)
     0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
     0x75, 0x01,                    //     REPORT_SIZE (1)
-    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x75, 0x06,                    //     REPORT_SIZE (6)
-    0x95, 0x01,                    //     REPORT_COUNT (1)
-    0x25, 0x3f,                    //     LOGICAL_MAXIMUM (63)
     0x09, 0x51,                    //     USAGE (Contact Identifier)
+    0x25, 0x1f,                    //     LOGICAL_MAXIMUM (31)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xa4,                          //     PUSH
     0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
-    0x75, 0x10,                    //     REPORT_SIZE (16)
-    0x26, 0x20, 0x03,              //     LOGICAL_MAXIMUM (800)
-    0x46, 0xad, 0x01,              //     PHYSICAL_MAXIMUM (429)
+    0x09, 0x30,                    //     USAGE (X)
+    0x26, DESC_CONFIG_WORD(TF_X_MAX),        //     LOGICAL_MAXIMUM (TF_X_MAX)
+    0x46, DESC_CONFIG_WORD(TF_X_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_X_PHYS_MAX)
     0x55, 0x0e,                    //     UNIT_EXPONENT (-2)
     0x65, 0x33,                    //     UNIT (Eng Lin:0x33)
-    0x09, 0x30,                    //     USAGE (X)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x26, 0xe0, 0x01,              //     LOGICAL_MAXIMUM (480)
-    0x46, 0x03, 0x01,              //     PHYSICAL_MAXIMUM (259)
     0x09, 0x31,                    //     USAGE (Y)
+    0x26, DESC_CONFIG_WORD(TF_Y_MAX),        //     LOGICAL_MAXIMUM (TF_Y_MAX)
+    0x46, DESC_CONFIG_WORD(TF_Y_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_Y_PHYS_MAX)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x05, 0x0d,                    //     USAGE_PAGE (Digitizers)
+    0x09, 0x48,                    //     USAGE (Width)
+    0x09, 0x49,                    //     USAGE (Height)
+    0x26, 0xff, 0x00,              //     LOGICAL_MAXIMUM (255)
+    0x46, DESC_CONFIG_WORD(TP_SIZE_PHYS_MAX), //     PHYSICAL_MAXIMUM (TP_SIZE_PHYS_MAX)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xb4,                          //     POP
     0xc0,                          //   END_COLLECTION
-    0x05, 0x0d,                    //   USAGE_PAGE (Digitizers)
     0x09, 0x22,                    //   USAGE (Finger)
     0xa1, 0x02,                    //   COLLECTION (Logical)
     0x09, 0x42,                    //     USAGE (Tip Switch)
     0x09, 0x32,                    //     USAGE (In Range)
-    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x09, 0x47,                    //     USAGE (Confidence)
     0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
     0x75, 0x01,                    //     REPORT_SIZE (1)
-    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x75, 0x06,                    //     REPORT_SIZE (6)
-    0x95, 0x01,                    //     REPORT_COUNT (1)
-    0x25, 0x3f,                    //     LOGICAL_MAXIMUM (63)
     0x09, 0x51,                    //     USAGE (Contact Identifier)
+    0x25, 0x1f,                    //     LOGICAL_MAXIMUM (31)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xa4,                          //     PUSH
     0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
-    0x75, 0x10,                    //     REPORT_SIZE (16)
-    0x26, 0x20, 0x03,              //     LOGICAL_MAXIMUM (800)
-    0x46, 0xad, 0x01,              //     PHYSICAL_MAXIMUM (429)
+    0x09, 0x30,                    //     USAGE (X)
+    0x26, DESC_CONFIG_WORD(TF_X_MAX),        //     LOGICAL_MAXIMUM (TF_X_MAX)
+    0x46, DESC_CONFIG_WORD(TF_X_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_X_PHYS_MAX)
     0x55, 0x0e,                    //     UNIT_EXPONENT (-2)
     0x65, 0x33,                    //     UNIT (Eng Lin:0x33)
-    0x09, 0x30,                    //     USAGE (X)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x26, 0xe0, 0x01,              //     LOGICAL_MAXIMUM (480)
-    0x46, 0x03, 0x01,              //     PHYSICAL_MAXIMUM (259)
     0x09, 0x31,                    //     USAGE (Y)
+    0x26, DESC_CONFIG_WORD(TF_Y_MAX),        //     LOGICAL_MAXIMUM (TF_Y_MAX)
+    0x46, DESC_CONFIG_WORD(TF_Y_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_Y_PHYS_MAX)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x05, 0x0d,                    //     USAGE_PAGE (Digitizers)
+    0x09, 0x48,                    //     USAGE (Width)
+    0x09, 0x49,                    //     USAGE (Height)
+    0x26, 0xff, 0x00,              //     LOGICAL_MAXIMUM (255)
+    0x46, DESC_CONFIG_WORD(TP_SIZE_PHYS_MAX), //     PHYSICAL_MAXIMUM (TP_SIZE_PHYS_MAX)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xb4,                          //     POP
     0xc0,                          //   END_COLLECTION
-    0x05, 0x0d,                    //   USAGE_PAGE (Digitizers)
     0x09, 0x22,                    //   USAGE (Finger)
     0xa1, 0x02,                    //   COLLECTION (Logical)
     0x09, 0x42,                    //     USAGE (Tip Switch)
     0x09, 0x32,                    //     USAGE (In Range)
-    0x15, 0x00,                    //     LOGICAL_MINIMUM (0)
+    0x09, 0x47,                    //     USAGE (Confidence)
     0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
     0x75, 0x01,                    //     REPORT_SIZE (1)
-    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x95, 0x03,                    //     REPORT_COUNT (3)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x75, 0x06,                    //     REPORT_SIZE (6)
-    0x95, 0x01,                    //     REPORT_COUNT (1)
-    0x25, 0x3f,                    //     LOGICAL_MAXIMUM (63)
     0x09, 0x51,                    //     USAGE (Contact Identifier)
+    0x25, 0x1f,                    //     LOGICAL_MAXIMUM (31)
+    0x75, 0x05,                    //     REPORT_SIZE (5)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xa4,                          //     PUSH
     0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
-    0x75, 0x10,                    //     REPORT_SIZE (16)
-    0x26, 0x20, 0x03,              //     LOGICAL_MAXIMUM (800)
-    0x46, 0xad, 0x01,              //     PHYSICAL_MAXIMUM (429)
+    0x09, 0x30,                    //     USAGE (X)
+    0x26, DESC_CONFIG_WORD(TF_X_MAX),        //     LOGICAL_MAXIMUM (TF_X_MAX)
+    0x46, DESC_CONFIG_WORD(TF_X_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_X_PHYS_MAX)
     0x55, 0x0e,                    //     UNIT_EXPONENT (-2)
     0x65, 0x33,                    //     UNIT (Eng Lin:0x33)
-    0x09, 0x30,                    //     USAGE (X)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
-    0x26, 0xe0, 0x01,              //     LOGICAL_MAXIMUM (480)
-    0x46, 0x03, 0x01,              //     PHYSICAL_MAXIMUM (259)
     0x09, 0x31,                    //     USAGE (Y)
+    0x26, DESC_CONFIG_WORD(TF_Y_MAX),        //     LOGICAL_MAXIMUM (TF_Y_MAX)
+    0x46, DESC_CONFIG_WORD(TF_Y_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_Y_PHYS_MAX)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x05, 0x0d,                    //     USAGE_PAGE (Digitizers)
+    0x09, 0x48,                    //     USAGE (Width)
+    0x09, 0x49,                    //     USAGE (Height)
+    0x26, 0xff, 0x00,              //     LOGICAL_MAXIMUM (255)
+    0x46, DESC_CONFIG_WORD(TP_SIZE_PHYS_MAX), //     PHYSICAL_MAXIMUM (TP_SIZE_PHYS_MAX)
+    0x75, 0x08,                    //     REPORT_SIZE (8)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
     0x81, 0x02,                    //     INPUT (Data,Var,Abs)
     0xb4,                          //     POP
     0xc0,                          //   END_COLLECTION
-    0x05, 0x0d,                    //   USAGE_PAGE (Digitizers)
     0x09, 0x54,                    //   USAGE (Contact Count)
-    0x95, 0x01,                    //   REPORT_COUNT (1)
-    0x75, 0x08,                    //   REPORT_SIZE (8)
     0x25, 0x05,                    //   LOGICAL_MAXIMUM (5)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
     0x81, 0x02,                    //   INPUT (Data,Var,Abs)
     0x85, 0x02,                    //   REPORT_ID (2)
     0x09, 0x55,                    //   USAGE (Contact Count Maximum)
     0xb1, 0x02,                    //   FEATURE (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+    0x09, 0x0e,                    // USAGE (Device Configuration)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x03,                    //   REPORT_ID (3)
+    0x09, 0x23,                    //   USAGE (Device Settings)
+    0xa1, 0x02,                    //   COLLECTION (Logical)
+    0x09, 0x52,                    //     USAGE (Device Mode)
+    0x09, 0x53,                    //     USAGE (Device Identifier)
+    0x25, 0x0a,                    //     LOGICAL_MAXIMUM (10)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0xb1, 0x02,                    //     FEATURE (Data,Var,Abs)
+    0xc0,                          //   END_COLLECTION
+    0xc0,                          // END_COLLECTION
+/* Single-touch mode:
+ * |  7  |  6  |  5  |  4  |  3  |  2  |  1  |  0  |
+ * | Padding                           |Range| Tip |
+ * | X L                                           |
+ * |   H                                           |
+ * | Y L                                           |
+ * |   H                                           |
+ */
+    0x09, 0x04,                    // USAGE (Touch Screen)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x0b,                    //   REPORT_ID (11)
+    0x09, 0x22,                    //   USAGE (Finger)
+    0xa1, 0x00,                    //   COLLECTION (Physical)
+    0x09, 0x42,                    //     USAGE (Tip Switch)
+    0x09, 0x32,                    //     USAGE (In Range)
+    0x25, 0x01,                    //     LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //     REPORT_SIZE (1)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x95, 0x06,                    //     REPORT_COUNT (6)
+    0x81, 0x03,                    //     INPUT (Cnst,Var,Abs)
+    0xa4,                          //     PUSH
+    0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
+    0x09, 0x30,                    //     USAGE (X)
+    0x26, DESC_CONFIG_WORD(TF_X_MAX),        //     LOGICAL_MAXIMUM (TF_X_MAX)
+    0x46, DESC_CONFIG_WORD(TF_X_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_X_PHYS_MAX)
+    0x55, 0x0e,                    //     UNIT_EXPONENT (-2)
+    0x65, 0x33,                    //     UNIT (Eng Lin:0x33)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x09, 0x31,                    //     USAGE (Y)
+    0x26, DESC_CONFIG_WORD(TF_Y_MAX),        //     LOGICAL_MAXIMUM (TF_Y_MAX)
+    0x46, DESC_CONFIG_WORD(TF_Y_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_Y_PHYS_MAX)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0xb4,                          //     POP
+    0xc0,                          //   END_COLLECTION
+    0xc0,                          // END_COLLECTION
+/* Mouse mode:
+ * |  7  |  6  |  5  |  4  |  3  |  2  |  1  |  0  |
+ * | Padding                           |Right|Left |
+ * | X L                                           |
+ * |   H                                           |
+ * | Y L                                           |
+ * |   H                                           |
+ */
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x02,                    // USAGE (Mouse)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x0a,                    //   REPORT_ID (10)
+    0x09, 0x01,                    //   USAGE (Pointer)
+    0xa1, 0x00,                    //   COLLECTION (Physical)
+    0x05, 0x09,                    //     USAGE_PAGE (Button)
+    0x19, 0x01,                    //     USAGE_MINIMUM (Button 1)
+    0x29, 0x02,                    //     USAGE_MAXIMUM (Button 2)
+    0x95, 0x02,                    //     REPORT_COUNT (2)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x95, 0x06,                    //     REPORT_COUNT (6)
+    0x81, 0x03,                    //     INPUT (Cnst,Var,Abs)
+    0xa4,                          //     PUSH
+    0x05, 0x01,                    //     USAGE_PAGE (Generic Desktop)
+    0x09, 0x30,                    //     USAGE (X)
+    0x26, DESC_CONFIG_WORD(TF_X_MAX),        //     LOGICAL_MAXIMUM (TF_X_MAX)
+    0x46, DESC_CONFIG_WORD(TF_X_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_X_PHYS_MAX)
+    0x55, 0x0e,                    //     UNIT_EXPONENT (-2)
+    0x65, 0x33,                    //     UNIT (Eng Lin:0x33)
+    0x75, 0x10,                    //     REPORT_SIZE (16)
+    0x95, 0x01,                    //     REPORT_COUNT (1)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0x09, 0x31,                    //     USAGE (Y)
+    0x26, DESC_CONFIG_WORD(TF_Y_MAX),        //     LOGICAL_MAXIMUM (TF_Y_MAX)
+    0x46, DESC_CONFIG_WORD(TF_Y_PHYS_MAX),   //     PHYSICAL_MAXIMUM (TF_Y_PHYS_MAX)
+    0x81, 0x02,                    //     INPUT (Data,Var,Abs)
+    0xb4,                          //     POP
+    0xc0,                          //   END_COLLECTION
+    0xc0,                          // END_COLLECTION
+    0x05, 0x80,                    // USAGE_PAGE (Monitor)
+    0x09, 0x01,                    // USAGE (Monitor Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x04,                    //   REPORT_ID (4)
+    0x05, 0x82,                    //   USAGE_PAGE (VESA Virtual Controls)
+    0x09, 0x10,                    //   USAGE (Brightness)
+    0x26, 0xff, 0x00,              //   LOGICAL_MAXIMUM (255)
+    0x75, 0x08,                    //   REPORT_SIZE (8)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0xb1, 0x02,                    //   FEATURE (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+    0x06, 0x00, 0xff,              // USAGE_PAGE (Vendor Defined Page 1)
+    0x09, 0x01,                    // USAGE (Vendor Usage 1)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, 0x05,                    //   REPORT_ID (5)
+    0x09, 0x02,                    //   USAGE (Vendor Usage 2)
+    0x95, sizeof(cfg_settings),    //   REPORT_COUNT (sizeof(cfg_settings))
+    0xb1, 0x02,                    //   FEATURE (Data,Var,Abs)
+    0x85, 0x06,                    //   REPORT_ID (6)
+    0x09, 0x03,                    //   USAGE (Vendor Usage 3)
+    0x95, sizeof(boot_diag),       //   REPORT_COUNT (sizeof(boot_diag))
+    0xb1, 0x03,                    //   FEATURE (Cnst,Var,Abs)
+    0x85, 0x07,                    //   REPORT_ID (7)
+    0x09, 0x04,                    //   USAGE (Vendor Usage 4)
+    0x95, sizeof(stats_counters),  //   REPORT_COUNT (sizeof(stats_counters))
+    0xb1, 0x03,                    //   FEATURE (Cnst,Var,Abs)
+    0x85, 0x08,                    //   REPORT_ID (8)
+    0x09, 0x05,                    //   USAGE (Vendor Usage 5)
+    0x95, LAT_STAGES * LAT_BUCKETS,          //   REPORT_COUNT (LAT_STAGES * LAT_BUCKETS)
+    0xb1, 0x03,                    //   FEATURE (Cnst,Var,Abs)
+    0x85, 0x09,                    //   REPORT_ID (9)
+    0x09, 0x06,                    //   USAGE (Vendor Usage 6)
+    0x95, sizeof(syn_control),     //   REPORT_COUNT (sizeof(syn_control))
+    0xb1, 0x02,                    //   FEATURE (Data,Var,Abs)
     0xc0                           // END_COLLECTION
     }
 };// end of HID report descriptor
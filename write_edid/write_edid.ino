@@ -15,30 +15,20 @@ const uint8_t PROGMEM eepromdat[128] = {
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x17,
 };
 
-// I2C eeprom dumper
-byte i2c_eeprom_read_byte(uint8_t deviceaddress, uint16_t eeaddress );
-
-#define EEPROMSIZE 256UL  // 0.5 Kb
+#define EEPROM_ADDR 0x50
+#define EEPROMSIZE 256UL  // 24AA02, 2 Kbit
 #define ADDRESS_SIZE 8
+#define PAGE_SIZE 8       // Bytes one write may cover without wrapping
+#define READ_CHUNK 16     // Sequential read length, within the Wire buffer
+#define WRITE_TIMEOUT 10  // ms, the 24AA02 needs at most 5 per write
 
-byte i2c_eeprom_read_byte(uint8_t deviceaddress, uint16_t eeaddress ) {
-    byte rdata = 0xFF;
-#if (ADDRESS_SIZE == 16)
-    Wire.beginTransmission(deviceaddress);
-    Wire.write((eeaddress >> 8)); // MSB
-#else
-    //deviceaddress |= (eeaddress >> 8);
-    Wire.beginTransmission(deviceaddress); // MSB
-#endif
-    Wire.write(eeaddress); // LSB
-    Wire.endTransmission();
-    Wire.requestFrom(deviceaddress, (uint8_t)1);
-    while (!Wire.available()); 
-    rdata = Wire.read();
-    return rdata;
+static uint8_t eeprom[EEPROMSIZE];
+
+static uint8_t image_byte(uint16_t addr) {
+    return (addr < sizeof(eepromdat)) ? pgm_read_byte(eepromdat + addr) : 0xFF;
 }
 
-void i2c_eeprom_write_byte(uint8_t deviceaddress, uint16_t eeaddress, byte data ) {
+static void i2c_eeprom_address(uint8_t deviceaddress, uint16_t eeaddress) {
 #if (ADDRESS_SIZE == 16)
     Wire.beginTransmission(deviceaddress);
     Wire.write((eeaddress >> 8)); // MSB
@@ -47,44 +37,88 @@ void i2c_eeprom_write_byte(uint8_t deviceaddress, uint16_t eeaddress, byte data
     Wire.beginTransmission(deviceaddress); // MSB
 #endif
     Wire.write((byte)eeaddress); // LSB
-    Wire.write((byte)data);
-    Wire.endTransmission();
 }
-  
+
+// Read len bytes from eeaddress on, continuing from the address reached by
+// the previous chunk instead of setting it again for every byte
+bool i2c_eeprom_read(uint8_t deviceaddress, uint16_t eeaddress, uint8_t *data, uint16_t len) {
+    i2c_eeprom_address(deviceaddress, eeaddress);
+    if (Wire.endTransmission() != 0) return false;
+    while (len) {
+        uint8_t n = (len < READ_CHUNK) ? len : READ_CHUNK;
+        if (Wire.requestFrom(deviceaddress, n) != n) return false;
+        for (uint8_t i = 0; i < n; i++) *data++ = Wire.read();
+        len -= n;
+    }
+    return true;
+}
+
+// Poll for the ACK the EEPROM withholds while a write is in progress,
+// instead of waiting the worst case write time
+bool i2c_eeprom_wait(uint8_t deviceaddress) {
+    unsigned long start = millis();
+    do {
+        Wire.beginTransmission(deviceaddress);
+        if (Wire.endTransmission() == 0) return true;
+    } while (millis() - start < WRITE_TIMEOUT);
+    return false;
+}
+
+// Write up to a page, which must not cross a page boundary
+bool i2c_eeprom_write_page(uint8_t deviceaddress, uint16_t eeaddress, const uint8_t *data, uint8_t len) {
+    i2c_eeprom_address(deviceaddress, eeaddress);
+    Wire.write(data, len);
+    if (Wire.endTransmission() != 0) return false;
+    return i2c_eeprom_wait(deviceaddress);
+}
+
+// CRC-16/CCITT, printed after verifying so units can be checked against the
+// image without reading the dump
+static uint16_t crc16(const uint8_t *data, uint16_t len) {
+    uint16_t crc = 0xFFFF;
+    while (len--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void fail(const __FlashStringHelper *what, uint16_t addr) {
+    Serial.print(what); Serial.print(F(" at 0x")); Serial.println(addr, HEX);
+    while (1);
+}
 
 void setup() {
   Wire.begin(); // initialise the connection
+  Wire.setClock(400000); // The 24AA02 runs at 400 kHz from 2.5 V
   Serial.begin(9600);
   Serial.println(F("EEPROM WRITER"));
   Serial.print(F("EEPROM data size: "));
   Serial.println(sizeof(eepromdat));
   Serial.println(F("Hit any key & return to start"));
   while (!Serial.available());
-  byte b;
   Serial.println("Starting");
-  for (uint16_t addr = 0; addr < EEPROMSIZE; addr++) {
-    if (addr < sizeof(eepromdat)) {
-      b = pgm_read_byte(eepromdat+addr);
-    } else {
-      b = 0xFF;
-    }
-     i2c_eeprom_write_byte(0x50, addr, b);
-     delay(5);
-     if ((addr % 32) == 0)
-       Serial.println();
-     Serial.print("0x");
-     if (b < 0x10) Serial.print('0');
-     Serial.print(b, HEX); //print content to serial port
-     Serial.print(", ");
+  unsigned long start = millis();
+
+  // Only rewrite the pages that differ from the image
+  if (!i2c_eeprom_read(EEPROM_ADDR, 0, eeprom, EEPROMSIZE)) fail(F("read failed"), 0);
+  uint8_t page[PAGE_SIZE];
+  uint8_t written = 0;
+  for (uint16_t addr = 0; addr < EEPROMSIZE; addr += PAGE_SIZE) {
+    for (uint8_t i = 0; i < PAGE_SIZE; i++) page[i] = image_byte(addr + i);
+    if (memcmp(page, eeprom + addr, PAGE_SIZE) == 0) continue;
+    if (!i2c_eeprom_write_page(EEPROM_ADDR, addr, page, PAGE_SIZE)) fail(F("write failed"), addr);
+    written++;
   }
-  Serial.println("\n\r========\n\rFinished!");
+  Serial.print(written); Serial.print(F(" of ")); Serial.print(EEPROMSIZE / PAGE_SIZE);
+  Serial.println(F(" pages written"));
+
+  if (!i2c_eeprom_read(EEPROM_ADDR, 0, eeprom, EEPROMSIZE)) fail(F("read failed"), 0);
+  unsigned long elapsed = millis() - start;
   for (uint16_t addr = 0; addr < EEPROMSIZE; addr++) {
-    if (addr < sizeof(eepromdat)) {
-      b = pgm_read_byte(eepromdat+addr);
-    } else {
-      b = 0xFF;
-    }
-    uint8_t d =  i2c_eeprom_read_byte(0x50, addr);
+    uint8_t d = eeprom[addr];
     if ((addr % 32) == 0)
       Serial.println();
     Serial.print("0x");
@@ -92,14 +126,12 @@ void setup() {
     Serial.print(d, HEX); //print content to serial port
     Serial.print(", ");
 
-    if (b != d) {
-       Serial.print(F("verification failed at 0x")); Serial.println(addr);
-       while (1);
-     }
+    if (image_byte(addr) != d) fail(F("verification failed"), addr);
   }
   Serial.println(F("\n\r\n\rVerified!"));
+  Serial.print(F("CRC 0x")); Serial.print(crc16(eeprom, EEPROMSIZE), HEX);
+  Serial.print(F(", ")); Serial.print(elapsed); Serial.println(F(" ms"));
 }
 
 void loop() {
 }
-